@@ -3,7 +3,11 @@
 #include "Triangle.hpp"
 #include "Matrix4x4.hpp"
 #include "Mesh.hpp"
-#include <algorithm>
+#include "MeshCache.hpp"
+#include "VertexStream.hpp"
+#include "Camera.hpp"
+#include "Transform.hpp"
+#include "Renderer3D.hpp"
 
 class Graphics3DEngine : public CGE::BaseGameEngine{
 public:
@@ -13,7 +17,8 @@ public:
 
     bool userCreate() override {
 
-        if (!m_mesh.loadFromFile("3D Models/teapot.obj")) {
+        // Binary cache next to model is used after first launch
+        if (!GE::MeshCache::load("3D Models/teapot.obj", m_mesh)) {
             return false;
         }
 
@@ -22,8 +27,26 @@ public:
         float fovDegrees = 90.0f;
         float aspectRatio = (float)m_screenHeight / (float)m_screenWidth;
 
-        // Matrix that projects 3D image to 2D
-        m_projectionMatrix = GE::Matrix4x4::makeProjection(fovDegrees, aspectRatio, zNear, zFar);
+        // Camera that projects 3D image to 2D
+        m_camera.setProjection(fovDegrees, aspectRatio, zNear, zFar);
+
+        // Model is placed in front of camera
+        m_modelTransform.setPosition({ 0.0f, 0.0f, 6.0f });
+
+        // Every light level of grey ramp gets its cell once, triangles only index it
+        CGE::ShadeRamp ramp;
+        std::vector<GE::Cell> shadeRamp;
+        for (int i = 0; i < ramp.getLevelCount(); ++i) {
+            CHAR_INFO const &c = ramp.lookup((i + 0.5f) / ramp.getLevelCount());
+            shadeRamp.push_back({ c.Char.UnicodeChar, c.Attributes });
+        }
+        m_renderer.setShadeRamp(shadeRamp);
+        m_renderer.setLightDirection({ 0.0f, 0.0f, -1.0f });
+
+        // Big models are transformed and drawn by all engine threads
+        m_renderer.setParallelFor([this](int count, std::function<void(int)> const &job) {
+            getThreadPool().parallelFor(count, job);
+        }, (int)getThreadPool().getNumThreads());
 
         return true;
     }
@@ -36,164 +59,31 @@ public:
         // Variable for rotating points
         m_theta += 1.0f * elapsedTime;
 
-        // Vector of objects projected to 2D that will be rendered
-        std::vector<GE::Triangle> trianglesToDraw;
-
-        // Draw triangles
-        for (auto const &triangle : m_mesh.m_triangles) {
-
-            // Matrixes for rotating points around X and Z axis
-            GE::Matrix4x4 rotX = GE::Matrix4x4::makeRotationX(m_theta * 0.5f);
-            GE::Matrix4x4 rotZ = GE::Matrix4x4::makeRotationZ(m_theta);
-
-            // Matrix to offset triangle
-            GE::Matrix4x4 translationMatrix = GE::Matrix4x4::makeTranslation(0.0f, 0.0f, 6.0f);
-
-            // Combining all triangle rotations and translations into one matrix(order must be kept!)
-            GE::Matrix4x4 worldMatrix = rotZ.multiplyMatrix(rotX);
-            worldMatrix = worldMatrix.multiplyMatrix(translationMatrix);
-
-            // Modified triangle
-            GE::Triangle transformedTriangle;
-            for (int i = 0; i < 3; ++i) {
-                transformedTriangle.m_vertices[i] = worldMatrix.multiplyVector(triangle.m_vertices[i]);
-            }
-
-            // Two sides of a triangle
-            GE::Vec3D line1 = transformedTriangle.m_vertices[1] - transformedTriangle.m_vertices[0];
-            GE::Vec3D line2 = transformedTriangle.m_vertices[2] - transformedTriangle.m_vertices[0];
-
-            // Normal vector for our triangle
-            GE::Vec3D normal = line1.crossProduct(line2);
-
-            // Normalizing normal vector
-            normal.normalize();
-
-            // Calculating dot product between normal and vector from camera to point of a triangle
-            // We can choose any point of a triangle bcz they all lie in a plane
-            float dotProduct = normal.dotProduct(transformedTriangle.m_vertices[0] - m_camera);
-
-            // We can only see the side of a cube if dot product < 0
-            if (dotProduct < 0.0f) {
-
-                // Illumination (normalized vector)
-                GE::Vec3D lightDirection = { 0.0f, 0.0f, -1.0f };
-                lightDirection.normalize();
+        // Rotate model around Z and then X axis, transform combines rotation and offset into one matrix
+        m_modelTransform.setRotation(m_theta * 0.5f, 0.0f, m_theta);
 
-                // Dot product between normal and light direction vectors
-                float dp = normal.dotProduct(lightDirection);
-
-                // Getting color of a cube pixel and pixel type using illumination power
-                CHAR_INFO c = getColor(dp);
-                transformedTriangle.m_color = c.Attributes;
-                transformedTriangle.m_pixel = c.Char.UnicodeChar;
-
-                // Project triangle from 3D to 2D
-                GE::Triangle projectedTriang{};
-                for (int i = 0; i < 3; ++i) {
-                    projectedTriang.m_vertices[i] = m_projectionMatrix.multiplyVector(transformedTriangle.m_vertices[i]);
-                    projectedTriang.m_vertices[i] /= projectedTriang.m_vertices[i].m_w;
-                }
-                projectedTriang.m_color = transformedTriangle.m_color;
-                projectedTriang.m_pixel = transformedTriangle.m_pixel;
-
-                // Scale into view
-                for (int i = 0; i < 3; ++i) {
-
-                    // Shift normalized coordinates from [-1; +1] to [0; +2] 
-                    GE::Vec3D offsetView = { 1.0f, 1.0f, 0.0f };
-                    projectedTriang.m_vertices[i] += offsetView;
-
-                    // Divide coordinates to become [0; +1] and muliply them by screen dimensions 
-                    projectedTriang.m_vertices[i].m_x *= 0.5f * (float)m_screenWidth;
-                    projectedTriang.m_vertices[i].m_y *= 0.5f * (float)m_screenHeight;
-                }
-
-                // Add triangle to vector of objects that will be rendered
-                trianglesToDraw.push_back(projectedTriang);
-
-            }
-        }
-
-        // Sort triangles to draw from farest to closest
-        // Need this to render triangles in correct order
-        std::sort(
-            trianglesToDraw.begin(),
-            trianglesToDraw.end(),
-            [](GE::Triangle const &t1, GE::Triangle const &t2) {
-                float z1 = (t1.m_vertices[0].m_z + t1.m_vertices[1].m_z + t1.m_vertices[2].m_z) / 3.0f;
-                float z2 = (t2.m_vertices[0].m_z + t2.m_vertices[1].m_z + t2.m_vertices[2].m_z) / 3.0f;
-                return z1 > z2;
-            }
-        );
-
-        for (auto const &triangle : trianglesToDraw) {
-
-            fillTriangle(
-                (short)triangle.m_vertices[0].m_x, (short)triangle.m_vertices[0].m_y,
-                (short)triangle.m_vertices[1].m_x, (short)triangle.m_vertices[1].m_y,
-                (short)triangle.m_vertices[2].m_x, (short)triangle.m_vertices[2].m_y,
-                triangle.m_pixel,
-                triangle.m_color
-            );
-
-            //Uncomment for debugging - will show all the triangles
-            /*
-            drawTriangle(
-                (short)triangle.m_vertices[0].m_x, (short)triangle.m_vertices[0].m_y,
-                (short)triangle.m_vertices[1].m_x, (short)triangle.m_vertices[1].m_y,
-                (short)triangle.m_vertices[2].m_x, (short)triangle.m_vertices[2].m_y,
-                CGE::Pixel::Solid,
-                CGE::Color::FG_Black
-            );
-            */
-        }
+        // Renderer culls, lights, projects, sorts and draws triangles straight into screen sprite
+        CGE::Sprite *screen = getDrawTarget();
+        m_renderer.beginFrame(m_camera, GE::RenderTarget{ screen->getPixelData(), screen->getColorData(), screen->getWidth(), screen->getHeight() });
+        m_renderer.submit(m_mesh, m_modelTransform.getMatrix());
+        m_renderer.flush();
 
         return true;
     }
 
-    // Get color and pixel type by giving value of light that illuminates point we are shading
-    CHAR_INFO getColor(float lum) {
-        CGE::baseColorType bgCol, fgCol;
-        CGE::basePixelType pix;
-        int pixelBw = (int)(13.0f * lum);
-        switch (pixelBw) {
-        case 0:  bgCol = CGE::Color::BG_Black; fgCol = CGE::Color::FG_Black; pix = CGE::Pixel::Solid; break;
-
-        case 1:  bgCol = CGE::Color::BG_Black; fgCol = CGE::Color::FG_DarkGrey; pix = CGE::Pixel::Quarter; break;
-        case 2:  bgCol = CGE::Color::BG_Black; fgCol = CGE::Color::FG_DarkGrey; pix = CGE::Pixel::Half; break;
-        case 3:  bgCol = CGE::Color::BG_Black; fgCol = CGE::Color::FG_DarkGrey; pix = CGE::Pixel::ThreeQuarters; break;
-        case 4:  bgCol = CGE::Color::BG_Black; fgCol = CGE::Color::FG_DarkGrey; pix = CGE::Pixel::Solid; break;
-
-        case 5:  bgCol = CGE::Color::BG_DarkGrey; fgCol = CGE::Color::FG_Grey; pix = CGE::Pixel::Quarter; break;
-        case 6:  bgCol = CGE::Color::BG_DarkGrey; fgCol = CGE::Color::FG_Grey; pix = CGE::Pixel::Half; break;
-        case 7:  bgCol = CGE::Color::BG_DarkGrey; fgCol = CGE::Color::FG_Grey; pix = CGE::Pixel::ThreeQuarters; break;
-        case 8:  bgCol = CGE::Color::BG_DarkGrey; fgCol = CGE::Color::FG_Grey; pix = CGE::Pixel::Solid; break;
-
-        case 9:  bgCol = CGE::Color::BG_Grey; fgCol = CGE::Color::FG_White; pix = CGE::Pixel::Quarter; break;
-        case 10: bgCol = CGE::Color::BG_Grey; fgCol = CGE::Color::FG_White; pix = CGE::Pixel::Half; break;
-        case 11: bgCol = CGE::Color::BG_Grey; fgCol = CGE::Color::FG_White; pix = CGE::Pixel::ThreeQuarters; break;
-        case 12: bgCol = CGE::Color::BG_Grey; fgCol = CGE::Color::FG_White; pix = CGE::Pixel::Solid; break;
-
-        default: bgCol = CGE::Color::BG_Black; fgCol = CGE::Color::FG_Black; pix = CGE::Pixel::Solid; break;
-        }
-
-        CHAR_INFO c;
-        c.Attributes = bgCol | fgCol;
-        c.Char.UnicodeChar = pix;
-        return c;
-    }
-
 private:
 
     // Rendered model
-    GE::Mesh m_mesh;
+    GE::IndexedMesh m_mesh;
+
+    // Position and rotation of model
+    GE::Transform m_modelTransform;
 
-    // Matrix that projects 3D image to 2D
-    GE::Matrix4x4 m_projectionMatrix;
+    // View point and projection of 3D image to 2D
+    GE::Camera m_camera;
 
-    // View point
-    GE::Vec3D m_camera{};
+    // Keeps its buffers between frames
+    GE::Renderer3D m_renderer;
 
     // Variable to rotate model
     float m_theta = 0.0f;
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "VertexStream.hpp"
+#include <cfloat>
+
+namespace GE {
+
+    // Axis aligned bounding box, empty box has min bigger than max
+    // FLT_MAX is used because Windows.h defines max macro
+    struct AABB {
+        Vec3D m_min{ FLT_MAX, FLT_MAX, FLT_MAX };
+        Vec3D m_max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        bool isEmpty() const;
+
+        void extend(Vec3D const &point);
+
+        void extend(AABB const &box);
+
+        Vec3D getCenter() const;
+
+        // Half of box size along every axis
+        Vec3D getExtents() const;
+
+        static AABB fromStream(VertexStream const &vertices);
+    };
+
+} // GE
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Matrix4x4.hpp"
+
+namespace GE {
+
+    // Camera with position, yaw and pitch angles and perspective projection
+    // View, projection and their combination are rebuilt only when camera changed
+    // Not thread safe - matrices are cached inside of getters
+    class Camera {
+    public:
+
+        Camera(float fovDegrees = 90.0f, float aspectRatio = 1.0f, float zNear = 0.1f, float zFar = 1000.0f);
+
+        void setProjection(float fovDegrees, float aspectRatio, float zNear, float zFar);
+
+        float getNear() const;
+
+        float getFar() const;
+
+        void setPosition(Vec3D const &position);
+
+        void move(Vec3D const &offset);
+
+        Vec3D const &getPosition() const;
+
+        // Rotation around Y axis in radians, 0 looks along +Z
+        void setYaw(float angleRad);
+
+        float getYaw() const;
+
+        // Rotation up and down in radians
+        void setPitch(float angleRad);
+
+        float getPitch() const;
+
+        // Normalized direction camera looks at
+        Vec3D const &getLookDirection() const;
+
+        // Moves world so camera is at (0, 0, 0) looking along +Z
+        Matrix4x4 const &getView() const;
+
+        Matrix4x4 const &getProjection() const;
+
+        // View and projection combined
+        Matrix4x4 const &getViewProjection() const;
+
+        // Increased every time camera changes
+        unsigned getVersion() const;
+
+    private:
+
+        void viewChanged();
+
+        void update() const;
+
+        Vec3D m_position{ 0.0f, 0.0f, 0.0f };
+        float m_yaw = 0.0f;
+        float m_pitch = 0.0f;
+
+        float m_zNear;
+        float m_zFar;
+
+        unsigned m_version = 1;
+
+        mutable Vec3D m_lookDir{ 0.0f, 0.0f, 1.0f };
+        mutable Matrix4x4 m_view = Matrix4x4::getIdentity();
+        mutable Matrix4x4 m_projection{};
+        mutable Matrix4x4 m_viewProjection{};
+        mutable bool m_viewDirty = true;
+        mutable bool m_viewProjectionDirty = true;
+    };
+
+} // GE
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Vec2D.hpp"
+#include "Vec3D.hpp"
+#include <cstdint>
+
+namespace GE {
+
+    // Vertex in homogeneous clip space(before dividing by w) and its texture coordinates
+    // Both change linearly along triangle edges in clip space, so new vertices get them with one interpolation
+    struct ClipVertex {
+        Vec3D m_position;
+        Vec2D m_texture;
+    };
+
+    // Sutherland-Hodgman clipping of triangles against planes of view volume in clip space
+    // -w <= x <= w, -w <= y <= w, 0 <= z <= w
+    class Clipper {
+    public:
+
+        enum Plane : uint32_t {
+            Left = 1,
+            Right = 2,
+            Bottom = 4,
+            Top = 8,
+            Near = 16,
+            Far = 32,
+            All = 63
+        };
+
+        // Triangle can have at most one new vertex for every plane
+        static constexpr int maxVertices = 9;
+
+        // Guard band is this many times bigger than screen, rasterizer must handle cells outside of screen
+        // Triangles that only cross screen edges inside of guard band are not clipped by side planes
+        explicit Clipper(float guardBand = 4.0f);
+
+        // Bit for every plane vertex is outside of
+        uint32_t getOutcode(Vec3D const &position) const;
+
+        // Side planes that vertex is outside of when they are moved to edges of guard band
+        uint32_t getGuardOutcode(Vec3D const &position) const;
+
+        // Planes that triangle with given vertex outcodes must be clipped by, 0 if it can be drawn as is
+        // rejected is set if triangle is completely outside of one plane
+        uint32_t getClipPlanes(uint32_t const codes[3], uint32_t const guardCodes[3], bool &rejected) const;
+
+        // Clips triangle by planes and writes polygon to out(maxVertices elements)
+        // Returns number of vertices in polygon, less than 3 if nothing is left
+        int clipTriangle(ClipVertex const in[3], uint32_t planes, ClipVertex *out) const;
+
+    private:
+
+        float getDistance(Vec3D const &position, uint32_t plane) const;
+
+        float m_guardBand;
+
+    };
+
+} // GE
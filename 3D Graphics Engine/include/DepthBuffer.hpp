@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace GE {
+
+    // Depth of every cell stored as 1 / w, 0 means nothing was drawn
+    // Coarse level keeps farthest and nearest depth of every tile of tileSize x tileSize cells,
+    // so triangles behind everything in tile are rejected before any of their cells is tested
+    // Clearing only marks tiles, cells of tile are cleared when something is drawn to it first time
+    class DepthBuffer {
+    public:
+
+        static constexpr int tileSize = 8;
+
+        enum class Visibility {
+            // Behind all cells, nothing has to be drawn
+            Occluded,
+            // Every cell has to be tested
+            Partial,
+            // In front of all cells, cells don't have to be tested
+            Visible
+        };
+
+        // Keeps memory if buffer doesn't grow, contents are undefined until clear
+        void resize(int width, int height);
+
+        void clear();
+
+        int getWidth() const;
+
+        int getHeight() const;
+
+        // Rectangles are minX <= x < maxX, minY <= y < maxY
+
+        // Compares depth range of something drawn in rectangle with tiles it touches
+        Visibility test(int minX, int minY, int maxX, int maxY, float nearest, float farthest);
+
+        // Must be called before cells in rectangle are read or written, nearest is largest depth that will be written
+        void beginWrite(int minX, int minY, int maxX, int maxY, float nearest);
+
+        // True if nothing was drawn to tile since clear, its cells hold old values
+        bool isTileCleared(int tx, int ty) const;
+
+        // Rows of getWidth cells
+        float *getData();
+
+    private:
+
+        // Writes to tile after which its farthest depth can be found again
+        static constexpr int rescanWrites = 8;
+
+        // Scans cells of tile for smallest depth
+        void updateFarthest(int tx, int ty);
+
+        struct Tile {
+            float m_farthest;
+            float m_nearest;
+            // Cells were not cleared yet, they are all 0
+            bool m_cleared;
+            // Number of writes after m_farthest was found, it can be too small
+            int m_writes;
+        };
+
+        int m_width = 0;
+        int m_height = 0;
+        int m_tilesX = 0;
+        int m_tilesY = 0;
+        std::vector<float> m_depth;
+        std::vector<Tile> m_tiles;
+    };
+
+} // GE
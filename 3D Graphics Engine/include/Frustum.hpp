@@ -0,0 +1,34 @@
+#pragma once
+
+#include "AABB.hpp"
+#include "Matrix4x4.hpp"
+
+namespace GE {
+
+    // Plane a*x + b*y + c*z + d = 0, points with positive distance are in front of it
+    struct Plane {
+        Vec3D m_normal;
+        float m_d;
+
+        float getDistance(Vec3D const &point) const;
+    };
+
+    // Part of space camera can see - 6 planes facing inside
+    struct Frustum {
+        enum class Containment {
+            Outside,
+            Intersects,
+            Inside
+        };
+
+        // Left, right, bottom, top, near, far
+        Plane m_planes[6];
+
+        // Planes are taken from columns of view projection matrix(Gribb and Hartmann)
+        // Objects must be in same space as matrix input - world space for camera view projection
+        static Frustum fromMatrix(Matrix4x4 const &viewProjection);
+
+        Containment test(AABB const &box) const;
+    };
+
+} // GE
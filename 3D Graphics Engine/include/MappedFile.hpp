@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace GE {
+
+    // Read only file mapped into memory
+    // Whole file can be accessed as one array of chars without copying it
+    class MappedFile {
+    public:
+
+        MappedFile() = default;
+
+        MappedFile(MappedFile const &) = delete;
+
+        MappedFile &operator=(MappedFile const &) = delete;
+
+        ~MappedFile();
+
+        bool open(std::string const &path);
+
+        void close();
+
+        char const *data() const;
+
+        size_t size() const;
+
+    private:
+
+#ifdef _WIN32
+        void *m_file = nullptr;
+        void *m_mapping = nullptr;
+#else
+        int m_fd = -1;
+#endif
+
+        char const *m_data = nullptr;
+        size_t m_size = 0;
+    };
+
+} // GE
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cmath>
+
+// C++17 has no std::is_constant_evaluated, compilers provide same check as builtin
+// Lets constexpr functions use fast non constexpr code(SIMD, std::sqrt) at runtime
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+    #define GE_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+    #define GE_CONSTANT_EVALUATED() true
+#endif
+
+namespace GE {
+
+    constexpr float pi = 3.14159265f;
+
+    constexpr float degreesToRadians(float degrees) {
+        return degrees * (pi / 180.0f);
+    }
+
+    // Sine and cosine of one angle - computed together so angle is reduced once
+    struct SinCos {
+        float m_sin;
+        float m_cos;
+    };
+
+    // Polynomial sine and cosine that can be used at compile time
+    // Angle is reduced to [-pi/2; pi/2] and series up to x^11 for sine and x^10 for cosine are used
+    // Absolute error is below 9e-7 for |angle| <= 2 * pi, for bigger angles float precision
+    // of reduction adds to it(up to 6e-6 near |angle| = 100 and 6e-5 near 1000, less when compiler uses FMA)
+    constexpr SinCos fastSinCos(float angleRad) {
+        // Angle is moved into [-pi; pi]
+        float turns = angleRad * (0.5f / pi);
+        float fullTurns = static_cast<float>(static_cast<long long>(turns + (turns >= 0.0f ? 0.5f : -0.5f)));
+        float x = angleRad - fullTurns * (2.0f * pi);
+
+        // Then mirrored into [-pi/2; pi/2], sine stays same and cosine changes sign
+        float cosSign = 1.0f;
+        if (x > 0.5f * pi) {
+            x = pi - x;
+            cosSign = -1.0f;
+        }
+        else if (x < -0.5f * pi) {
+            x = -pi - x;
+            cosSign = -1.0f;
+        }
+
+        float x2 = x * x;
+        float s = x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f + x2 * (-1.0f / 39916800.0f))))));
+        float c = 1.0f + x2 * (-1.0f / 2.0f + x2 * (1.0f / 24.0f + x2 * (-1.0f / 720.0f + x2 * (1.0f / 40320.0f + x2 * (-1.0f / 3628800.0f)))));
+        return SinCos{ s, cosSign * c };
+    }
+
+    // Sine and cosine of angle, at compile time or with GE_FAST_TRIG polynomial version is used
+    constexpr SinCos sinCos(float angleRad) {
+#ifndef GE_FAST_TRIG
+        if (!GE_CONSTANT_EVALUATED()) {
+            return SinCos{ std::sin(angleRad), std::cos(angleRad) };
+        }
+#endif
+        return fastSinCos(angleRad);
+    }
+
+    // Square root that can be used at compile time
+    constexpr float squareRoot(float val) {
+        if (!GE_CONSTANT_EVALUATED()) {
+            return std::sqrt(val);
+        }
+        if (!(val > 0.0f)) {
+            return 0.0f;
+        }
+        // Newton iterations until result stops changing
+        float res = val > 1.0f ? val : 1.0f;
+        for (int i = 0; i < 64; ++i) {
+            float next = 0.5f * (res + val / res);
+            if (next == res) {
+                break;
+            }
+            res = next;
+        }
+        return res;
+    }
+
+} // GE
@@ -1,47 +1,254 @@
 #pragma once
 
 #include "Vec3d.hpp"
+#include "VertexStream.hpp"
 #include <array>
 
 namespace GE {
 
+    // All operations except batch transforms are constexpr so constant matrices are built at compile time
     class Matrix4x4 {
 
-        class Row {
+        // Indexing is not checked - it is used for every element in hottest loops
+        class alignas(16) Row {
             
-            std::array<float, 4> m_vals;
+            std::array<float, 4> m_vals{};
 
         public:
 
-            float &operator[](int index);
+            constexpr float &operator[](int index) { return m_vals[index]; }
 
-            float operator[](int index) const;
+            constexpr float operator[](int index) const { return m_vals[index]; }
+
+            float *data() { return m_vals.data(); }
+
+            float const *data() const { return m_vals.data(); }
 
         };
 
-        std::array<Row, 4> m_rows;
+        std::array<Row, 4> m_rows{};
 
     public:
 
-        Row &operator[](int index);
+        constexpr Row &operator[](int index) { return m_rows[index]; }
+
+        constexpr Row const &operator[](int index) const { return m_rows[index]; }
+
+        constexpr Vec3D multiplyVector(Vec3D const &v) const {
+            Vec3D res{};
+#ifdef GE_USE_SSE
+            if (!GE_CONSTANT_EVALUATED()) {
+                // Result is sum of matrix rows scaled by vector components
+                simdTransform(&v.m_x, m_rows[0].data(), m_rows[1].data(), m_rows[2].data(), m_rows[3].data(), &res.m_x);
+                return res;
+            }
+#endif
+            res.m_x = v.m_x * m_rows[0][0] + v.m_y * m_rows[1][0] + v.m_z * m_rows[2][0] + v.m_w * m_rows[3][0];
+            res.m_y = v.m_x * m_rows[0][1] + v.m_y * m_rows[1][1] + v.m_z * m_rows[2][1] + v.m_w * m_rows[3][1];
+            res.m_z = v.m_x * m_rows[0][2] + v.m_y * m_rows[1][2] + v.m_z * m_rows[2][2] + v.m_w * m_rows[3][2];
+            res.m_w = v.m_x * m_rows[0][3] + v.m_y * m_rows[1][3] + v.m_z * m_rows[2][3] + v.m_w * m_rows[3][3];
+            return res;
+        }
+
+        constexpr Matrix4x4 multiplyMatrix(Matrix4x4 const &v) const {
+            Matrix4x4 res{};
+#ifdef GE_USE_SSE
+            if (!GE_CONSTANT_EVALUATED()) {
+                // Every row of result is row of this matrix multiplied by other matrix
+                for (int r = 0; r < 4; ++r) {
+                    simdTransform(m_rows[r].data(), v.m_rows[0].data(), v.m_rows[1].data(), v.m_rows[2].data(), v.m_rows[3].data(), res.m_rows[r].data());
+                }
+                return res;
+            }
+#endif
+            for (int c = 0; c < 4; ++c) {
+                for (int r = 0; r < 4; ++r) {
+                    res[r][c] = m_rows[r][0] * v[0][c] + m_rows[r][1] * v[1][c] + m_rows[r][2] * v[2][c] + m_rows[r][3] * v[3][c];
+                }
+            }
+            return res;
+        }
+
+        // Transforms count vertices from in and writes them to out(can be same array)
+        // If perspectiveDivide is true x, y and z of results are divided by w
+        void multiplyVectors(Vec3D const *in, Vec3D *out, size_t count, bool perspectiveDivide = false) const;
+
+        // Same for structure of arrays, out is resized to size of in(can be same stream)
+        void multiplyStream(VertexStream const &in, VertexStream &out, bool perspectiveDivide = false) const;
+
+        // Transforms only count vertices starting from first, out must already have size of in
+        void multiplyStream(VertexStream const &in, VertexStream &out, size_t first, size_t count, bool perspectiveDivide = false) const;
+
+        static constexpr Matrix4x4 getIdentity() {
+            Matrix4x4 m{};
+            for (int i = 0; i < 4; ++i) {
+                m[i][i] = 1.0f;
+            }
+            return m;
+        }
+
+        // Sine and cosine are computed once for every matrix
+        static constexpr Matrix4x4 makeRotationX(float angleRad) {
+            return makeRotationX(sinCos(angleRad));
+        }
+
+        static constexpr Matrix4x4 makeRotationY(float angleRad) {
+            return makeRotationY(sinCos(angleRad));
+        }
+
+        static constexpr Matrix4x4 makeRotationZ(float angleRad) {
+            return makeRotationZ(sinCos(angleRad));
+        }
+
+        // Same rotations from already computed sine and cosine of angle
+        static constexpr Matrix4x4 makeRotationX(SinCos angle) {
+            Matrix4x4 rotX{};
+            rotX[0][0] =  1.0f;
+            rotX[1][1] =  angle.m_cos;
+            rotX[1][2] = -angle.m_sin;
+            rotX[2][1] =  angle.m_sin;
+            rotX[2][2] =  angle.m_cos;
+            rotX[3][3] =  1.0f;
+            return rotX;
+        }
+
+        static constexpr Matrix4x4 makeRotationY(SinCos angle) {
+            Matrix4x4 rotY{};
+            rotY[0][0] =  angle.m_cos;
+            rotY[0][2] =  angle.m_sin;
+            rotY[2][0] = -angle.m_sin;
+            rotY[1][1] =  1.0f;
+            rotY[2][2] =  angle.m_cos;
+            rotY[3][3] =  1.0f;
+            return rotY;
+        }
+
+        static constexpr Matrix4x4 makeRotationZ(SinCos angle) {
+            Matrix4x4 rotZ{};
+            rotZ[0][0] =  angle.m_cos;
+            rotZ[0][1] = -angle.m_sin;
+            rotZ[1][0] =  angle.m_sin;
+            rotZ[1][1] =  angle.m_cos;
+            rotZ[2][2] =  1.0f;
+            rotZ[3][3] =  1.0f;
+            return rotZ;
+        }
+
+        static constexpr Matrix4x4 makeTranslation(float x, float y, float z) {
+            Matrix4x4 trans = Matrix4x4::getIdentity();
+            trans[3][0] = x;
+            trans[3][1] = y;
+            trans[3][2] = z;
+            return trans;
+        }
+
+        // Matrix that places object at pos and turns it to look at target
+        // @pos - where the object should be
+        // @target - point object looks at
+        // @up - objects vector that shows where up is
+        static constexpr Matrix4x4 makePointAt(Vec3D const &pos, Vec3D const &target, Vec3D const &up) {
+            // New Forward direction - for camera its the direction camera looks
+            Vec3D newForward = (target - pos).getNormalized();
+
+            // New Up direction
+            Vec3D r = newForward * up.dotProduct(newForward);
+            Vec3D newUp = (up - r).getNormalized();
+
+            // New Right direction
+            Vec3D newRight = newUp.crossProduct(newForward);
+
+            // Construct dimensioning and translationing matrix
+            Matrix4x4 res{};
+            res[0][0] = newRight.m_x;      res[0][1] = newRight.m_y;      res[0][2] = newRight.m_z;      res[0][3] = 0;
+            res[1][0] = newUp.m_x;         res[1][1] = newUp.m_y;         res[1][2] = newUp.m_z;         res[1][3] = 0;
+            res[2][0] = newForward.m_x;    res[2][1] = newForward.m_y;    res[2][2] = newForward.m_z;    res[2][3] = 0;
+            res[3][0] = pos.m_x;           res[3][1] = pos.m_y;           res[3][2] = pos.m_z;           res[3][3] = 1;
+            return res;
+        }
+
+        // Inverse of matrix that only rotates and translates(pointAt matrix -> lookAt matrix)
+        constexpr Matrix4x4 getQuickInverse() const {
+            Matrix4x4 const &matrix = *this;
+            Matrix4x4 res{};
+            res[0][0] = matrix[0][0];    res[0][1] = matrix[1][0];    res[0][2] = matrix[2][0];    res[0][3] = 0.0f;
+            res[1][0] = matrix[0][1];    res[1][1] = matrix[1][1];    res[1][2] = matrix[2][1];    res[1][3] = 0.0f;
+            res[2][0] = matrix[0][2];    res[2][1] = matrix[1][2];    res[2][2] = matrix[2][2];    res[2][3] = 0.0f;
+            res[3][0] = -(matrix[3][0] * res[0][0] + matrix[3][1] * res[1][0] + matrix[3][2] * res[2][0]);
+            res[3][1] = -(matrix[3][0] * res[0][1] + matrix[3][1] * res[1][1] + matrix[3][2] * res[2][1]);
+            res[3][2] = -(matrix[3][0] * res[0][2] + matrix[3][1] * res[1][2] + matrix[3][2] * res[2][2]);
+            res[3][3] = 1.0f;
+            return res;
+        }
 
-        Row const &operator[](int index) const;
+        // Inverse of any matrix(model matrix with scale, projection), zero matrix if it can't be inverted
+        // Uses cofactors - slower than getQuickInverse so result should be reused
+        constexpr Matrix4x4 getInverse() const {
+            Matrix4x4 const &m = *this;
 
-        Vec3D multiplyVector(Vec3D const &v) const;
+            // 2x2 determinants of two lower and two upper rows
+            float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+            float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+            float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+            float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+            float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+            float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+            float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+            float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+            float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+            float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+            float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+            float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
 
-        Matrix4x4 multiplyMatrix(Matrix4x4 const &v) const;
+            Matrix4x4 res{};
+            float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            if (det == 0.0f) {
+                return res;
+            }
+            float invDet = 1.0f / det;
 
-        static Matrix4x4 getIdentity();
+            res[0][0] = ( m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * invDet;
+            res[0][1] = (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * invDet;
+            res[0][2] = ( m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * invDet;
+            res[0][3] = (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * invDet;
 
-        static Matrix4x4 makeRotationX(float angleRad);
+            res[1][0] = (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * invDet;
+            res[1][1] = ( m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * invDet;
+            res[1][2] = (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * invDet;
+            res[1][3] = ( m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * invDet;
 
-        static Matrix4x4 makeRotationY(float angleRad);
+            res[2][0] = ( m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * invDet;
+            res[2][1] = (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * invDet;
+            res[2][2] = ( m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * invDet;
+            res[2][3] = (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * invDet;
 
-        static Matrix4x4 makeRotationZ(float angleRad);
+            res[3][0] = (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * invDet;
+            res[3][1] = ( m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * invDet;
+            res[3][2] = (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * invDet;
+            res[3][3] = ( m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * invDet;
+            return res;
+        }
 
-        static Matrix4x4 makeTranslation(float x, float y, float z);
+        static constexpr Matrix4x4 makeScale(float x, float y, float z) {
+            Matrix4x4 scale{};
+            scale[0][0] = x;
+            scale[1][1] = y;
+            scale[2][2] = z;
+            scale[3][3] = 1.0f;
+            return scale;
+        }
 
-        static Matrix4x4 makeProjection(float fovDegrees, float aspectRatio, float zNear, float zFar);
+        static constexpr Matrix4x4 makeProjection(float fovDegrees, float aspectRatio, float zNear, float zFar) {
+            // 1 / tan(fov / 2)
+            SinCos halfFov = sinCos(degreesToRadians(fovDegrees * 0.5f));
+            float fovRad = halfFov.m_cos / halfFov.m_sin;
+            Matrix4x4 proj{};
+            proj[0][0] = aspectRatio * fovRad;
+            proj[1][1] = fovRad;
+            proj[2][2] = zFar / (zFar - zNear);
+            proj[3][2] = (-zNear * zFar) / (zFar - zNear);
+            proj[2][3] = 1.0f;
+            return proj;
+        }
 
     };
 
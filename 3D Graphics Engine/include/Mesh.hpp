@@ -1,10 +1,11 @@
 #pragma once
 
 #include "Triangle.hpp"
+#include "VertexStream.hpp"
+#include "AABB.hpp"
+#include <cstdint>
 #include <vector>
 #include <string>
-#include <fstream>
-#include <sstream>
 
 namespace GE {
 
@@ -20,6 +21,48 @@ namespace GE {
         bool loadFromFile(std::string const &path, bool hasTexture = false);
     };
 
+    // Mesh where every unique vertex is stored once and triangles refer to vertices by index
+    // Vertex shared by several triangles is transformed only once
+    struct IndexedMesh {
+        // Positions of unique vertices
+        VertexStream m_vertices;
+
+        // Texture vertex for every vertex, empty if mesh has no texture
+        std::vector<Vec2D> m_textures;
+
+        // Normal for every vertex, empty if file had no normals
+        std::vector<Vec3D> m_normals;
+
+        // Three vertex indices for every triangle
+        std::vector<uint32_t> m_indices;
+
+        // Unit normal of every triangle(w = 0), zero for degenerate triangles
+        // Functions that reorder or change triangles update it
+        std::vector<Vec3D> m_faceNormals;
+
+        // Box around all vertices
+        AABB m_bounds;
+
+        size_t getTriangleCount() const;
+
+        bool hasTexture() const;
+
+        bool hasNormals() const;
+
+        // Recomputes box around vertices after they were changed
+        void updateBounds();
+
+        // Recomputes normals of triangles after vertices or indices were changed
+        void updateFaceNormals();
+
+        bool loadFromFile(std::string const &path, bool hasTexture = false);
+
+        // Builds indexed mesh merging vertices that have same position(and texture vertex)
+        static IndexedMesh fromMesh(Mesh const &mesh);
+
+        static IndexedMesh fromMesh(TexturedMesh const &mesh, bool hasTexture = true);
+    };
+
 } // GE
 
 
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Frustum.hpp"
+#include "Mesh.hpp"
+
+namespace GE {
+
+    // Bounding volume hierarchy over triangles of indexed mesh
+    // Mesh is reordered while building so every node owns continuous range of triangles
+    // and vertices of its triangles are close together - whole node can be skipped or transformed at once
+    class MeshBVH {
+    public:
+
+        // Triangles and vertices of one node
+        // Vertex range can contain vertices used by other nodes too
+        struct Range {
+            uint32_t m_firstTriangle;
+            uint32_t m_triangleCount;
+            uint32_t m_firstVertex;
+            uint32_t m_vertexCount;
+        };
+
+        struct Node {
+            AABB m_bounds;
+            Range m_range;
+            // Index of first child, second child follows it, 0 for leaves
+            uint32_t m_firstChild;
+        };
+
+        // Leaves get at most leafSize triangles
+        // Mesh must not be changed after BVH was built for it
+        static MeshBVH build(IndexedMesh &mesh, size_t leafSize = 32);
+
+        // Appends ranges of nodes that are at least partially inside of frustum
+        // Neighbouring ranges are merged
+        void cull(Frustum const &frustum, std::vector<Range> &visible) const;
+
+        std::vector<Node> const &getNodes() const;
+
+    private:
+
+        void cullNode(uint32_t node, Frustum const &frustum, std::vector<Range> &visible) const;
+
+        std::vector<Node> m_nodes;
+
+    };
+
+} // GE
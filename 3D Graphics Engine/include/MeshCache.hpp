@@ -0,0 +1,32 @@
+#pragma once
+
+#include "MeshLOD.hpp"
+
+namespace GE {
+
+    // Binary copy of indexed mesh stored next to .obj file(model.obj -> model.obj.gemesh)
+    // Cache is used while size and modification time of .obj file match ones it was built from
+    // .obj is read only when its time changed but size didn't(copied file) - then its hash is compared
+    // Otherwise .obj is parsed again and cache is rewritten
+    class MeshCache {
+    public:
+
+        // Loads mesh from cache or from .obj file, creating cache for next time
+        // Mesh parsed from .obj is optimized with MeshOptimizer before it is saved
+        static bool load(std::string const &objPath, IndexedMesh &mesh, bool hasTexture = false);
+
+        // Same for whole chain of levels of detail built by MeshLOD::build with default settings
+        // Level 0 uses cache of load, every next level is cached in its own file, so simplifier runs only when .obj changes
+        static bool loadLOD(std::string const &objPath, MeshLOD &lod, bool hasTexture = false);
+
+        static std::string getCachePath(std::string const &objPath);
+
+        // Cache of simplified level(model.obj -> model.obj.lod1.gemesh)
+        static std::string getLevelCachePath(std::string const &objPath, size_t level);
+
+        // 64 bit FNV-1a hash of bytes
+        static uint64_t hashBytes(char const *data, size_t size);
+
+    };
+
+} // GE
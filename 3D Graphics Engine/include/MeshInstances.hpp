@@ -0,0 +1,63 @@
+#pragma once
+
+#include "MeshBVH.hpp"
+
+namespace GE {
+
+    // Many copies of one mesh, every copy(instance) with its own model matrix
+    // Mesh is stored once - instances only keep matrices and world space boxes, so memory grows with unique meshes
+    // Every property of instances is kept in its own array, so culling reads only boxes
+    // Boxes are split further into one array per coordinate, matrices stay whole because renderer
+    // reads both matrices of visible instance at once and multiplies them by rows
+    class MeshInstances {
+    public:
+
+        // Instance that passed culling, inside means whole box is in view and parts of mesh don't have to be culled
+        struct Visible {
+            uint32_t m_index;
+            bool m_inside;
+        };
+
+        // Mesh and its BVH must stay valid and unchanged while instances are used
+        explicit MeshInstances(IndexedMesh const &mesh, MeshBVH const *bvh = nullptr);
+
+        IndexedMesh const &getMesh() const;
+
+        MeshBVH const *getBVH() const;
+
+        // Returns index of new instance
+        uint32_t add(Matrix4x4 const &model);
+
+        // Moves instance, its inverse matrix and box are recomputed once here instead of every frame
+        void setModel(uint32_t index, Matrix4x4 const &model);
+
+        Matrix4x4 const &getModel(uint32_t index) const;
+
+        Matrix4x4 const &getModelInverse(uint32_t index) const;
+
+        // Box around instance in world space
+        AABB getBounds(uint32_t index) const;
+
+        size_t size() const;
+
+        void reserve(size_t count);
+
+        void clear();
+
+        // Appends instances with boxes at least partially inside of world space frustum
+        void cull(Frustum const &frustum, std::vector<Visible> &visible) const;
+
+    private:
+
+        IndexedMesh const *m_mesh;
+        MeshBVH const *m_bvh;
+
+        std::vector<Matrix4x4> m_models;
+        std::vector<Matrix4x4> m_modelInverses;
+
+        // World space boxes, one array for every coordinate
+        std::vector<float> m_minX, m_minY, m_minZ;
+        std::vector<float> m_maxX, m_maxY, m_maxZ;
+    };
+
+} // GE
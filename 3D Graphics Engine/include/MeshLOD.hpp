@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Camera.hpp"
+#include "MeshSimplifier.hpp"
+
+namespace GE {
+
+    // Chain of levels of detail, level 0 is original mesh and every next level has fewer triangles
+    // Renderer picks level from how big object is on screen so far objects cost few triangles
+    class MeshLOD {
+    public:
+
+        // Every level keeps about ratio of triangles of previous one
+        // Stops at maxLevels, below minTriangles or when simplifier can't remove more triangles
+        static MeshLOD build(IndexedMesh const &mesh, size_t maxLevels = 4, float ratio = 0.5f, size_t minTriangles = 64);
+
+        // Chain from already built levels(for example read from cache), first one is most detailed
+        static MeshLOD fromLevels(std::vector<IndexedMesh> levels);
+
+        size_t getLevelCount() const;
+
+        IndexedMesh &getLevel(size_t level);
+
+        IndexedMesh const &getLevel(size_t level) const;
+
+        // Most detailed level that has at most trianglesPerCell triangles for every screen cell covered by object
+        // Covered area is estimated from bounding sphere of mesh moved by model matrix
+        size_t selectLevel(Camera const &camera, float screenHeight, Matrix4x4 const &model = Matrix4x4::getIdentity(), float trianglesPerCell = 0.5f) const;
+
+    private:
+
+        std::vector<IndexedMesh> m_levels;
+
+    };
+
+} // GE
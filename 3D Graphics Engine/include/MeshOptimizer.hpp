@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Mesh.hpp"
+
+namespace GE {
+
+    // Average cache miss ratio(transformed vertices per triangle) before and after optimization
+    // 3 means no vertex reuse at all, 0.5 is close to best possible for big regular meshes
+    struct MeshOptimizerStats {
+        float m_acmrBefore;
+        float m_acmrAfter;
+    };
+
+    // Reorders indexed mesh so renderer reuses recently transformed vertices and reads vertex arrays in order
+    class MeshOptimizer {
+    public:
+
+        // Runs all steps below, returns cache miss ratios measured before and after
+        static MeshOptimizerStats optimize(IndexedMesh &mesh);
+
+        // Merges vertices that have same position, texture vertex and normal
+        // Positions that differ less than epsilon are treated as same
+        static void weldVertices(IndexedMesh &mesh, float epsilon = 0.0f);
+
+        // Reorders triangles so vertices used by next triangle are likely still in post transform cache
+        // Uses Tom Forsyth's linear-speed vertex cache optimization
+        static void optimizeVertexCache(IndexedMesh &mesh);
+
+        // Renumbers vertices in order of first use and removes unused ones
+        static void optimizeVertexFetch(IndexedMesh &mesh);
+
+        // Simulates FIFO cache of cacheSize vertices, returns number of cache misses per triangle
+        static float getACMR(std::vector<uint32_t> const &indices, size_t numVertices, size_t cacheSize = 16);
+
+    };
+
+} // GE
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include <cfloat>
+
+namespace GE {
+
+    // Reduces number of triangles of indexed mesh by collapsing edges
+    // Edge that changes shape least(smallest quadric error, Garland and Heckbert) is collapsed first
+    class MeshSimplifier {
+    public:
+
+        // Collapses edges until mesh has targetTriangles triangles or next collapse would add error bigger than maxError
+        // Error is squared distance to planes of original triangles, open borders are kept in place
+        // Textured meshes keep vertices at one of edge ends so texture vertices stay valid
+        static IndexedMesh simplify(IndexedMesh const &mesh, size_t targetTriangles, float maxError = FLT_MAX);
+
+    };
+
+} // GE
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Vec3D.hpp"
+#include "Vec2D.hpp"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace GE {
+
+    // Contents of .obj file as they are written in file
+    struct ObjData {
+        // Indices of one triangle corner into arrays below, -1 if index wasn't given
+        struct Corner {
+            int32_t m_position;
+            int32_t m_texture;
+            int32_t m_normal;
+        };
+
+        std::vector<Vec3D> m_positions;
+        std::vector<Vec2D> m_textures;
+        std::vector<Vec3D> m_normals;
+
+        // Three corners for every triangle, polygons are split into triangle fans
+        std::vector<Corner> m_corners;
+
+        size_t getTriangleCount() const;
+    };
+
+    // Reader of v, vt, vn and f lines of .obj file, other lines are skipped
+    // Faces can use a, a/b, a//c and a/b/c forms and negative(relative) indices
+    class ObjParser {
+    public:
+
+        // File is mapped into memory, big files are split into parts parsed in parallel
+        // Returns false if file can't be opened or has wrong indices
+        static bool parseFile(std::string const &path, ObjData &out);
+
+        static bool parse(char const *begin, char const *end, ObjData &out);
+
+    };
+
+} // GE
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <functional>
+
+namespace GE {
+
+    // Calls job(i) for every i in [0; count) and returns after all calls finished
+    // Matches CGE::ThreadPool::parallelFor so engine thread pool can be passed to 3DTools
+    using ParallelFor = std::function<void(int count, std::function<void(int)> const &job)>;
+
+} // GE
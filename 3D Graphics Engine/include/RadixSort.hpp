@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Parallel.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace GE {
+
+    // Element of sorted array - key and index of item it belongs to
+    struct SortKey {
+        uint32_t m_key;
+        uint32_t m_index;
+    };
+
+    // Stable LSD radix sort by 32 bit key, 8 bits per pass
+    // Time is linear in number of keys, passes where all keys have same byte are skipped
+    // Scratch buffers are kept between calls
+    class RadixSorter {
+    public:
+
+        // Sorts keys in ascending order
+        void sort(std::vector<SortKey> &keys);
+
+        // Same, but counting and moving keys is split between numTasks jobs for big arrays
+        void sort(std::vector<SortKey> &keys, ParallelFor const &parallelFor, int numTasks);
+
+        // Key that orders non negative floats same way as their values
+        static uint32_t floatKey(float val);
+
+    private:
+
+        std::vector<SortKey> m_scratch;
+
+        // 256 counters for every task
+        std::vector<uint32_t> m_counts;
+
+    };
+
+} // GE
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GE {
+
+    // Glyph and color attributes of one console cell
+    struct Cell {
+        uint16_t m_pixel;
+        uint16_t m_color;
+    };
+
+    // Cells renderer writes to - usually planes of console screen sprite
+    // Both planes store m_width cells in every row
+    struct RenderTarget {
+        uint16_t *m_pixels;
+        uint16_t *m_colors;
+        int m_width;
+        int m_height;
+    };
+
+    // Read only image with same layout as RenderTarget
+    struct Texture {
+        uint16_t const *m_pixels;
+        uint16_t const *m_colors;
+        int m_width;
+        int m_height;
+
+        // Coordinates are normalized and wrap around like in CGE::Sprite::samplePixel
+        Cell sample(float u, float v) const;
+    };
+
+} // GE
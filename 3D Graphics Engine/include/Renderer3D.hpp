@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Camera.hpp"
+#include "Clipper.hpp"
+#include "DepthBuffer.hpp"
+#include "MeshBVH.hpp"
+#include "MeshInstances.hpp"
+#include "RadixSort.hpp"
+#include "RenderTarget.hpp"
+#include "Triangle.hpp"
+
+namespace GE {
+
+    // Draws indexed meshes into console cells
+    // Meshes are submitted during frame and drawn together by flush
+    // All buffers are members that keep their capacity, so after first frames rendering doesn't allocate memory
+    class Renderer3D {
+    public:
+
+        enum class DepthMode {
+            // Triangles are sorted from farthest to closest and drawn over each other
+            Painter,
+            // Depth of every cell is stored and tested, triangles are drawn in submission order
+            DepthBuffer,
+            // Like DepthBuffer, but only triangle and texture coordinates of closest one are stored for every cell
+            // Textures are sampled after all triangles are drawn, once for every visible cell
+            Deferred
+        };
+
+        void setDepthMode(DepthMode mode);
+
+        DepthMode getDepthMode() const;
+
+        // Cells used for flat shaded triangles, first one for darkest light and last one for brightest
+        void setShadeRamp(std::vector<Cell> const &ramp);
+
+        // Direction to light in world space
+        void setLightDirection(Vec3D const &direction);
+
+        // Smallest light value given to triangles that face away from light
+        void setAmbient(float ambient);
+
+        // Lets renderer split big jobs between numThreads threads, for example with CGE::ThreadPool::parallelFor
+        // Big meshes are transformed and clipped in parallel, screen is drawn as tiles in parallel
+        void setParallelFor(ParallelFor parallelFor, int numThreads);
+
+        // Starts new frame - everything submitted before is dropped, depth buffer is cleared
+        void beginFrame(Camera const &camera, RenderTarget const &target);
+
+        // Flat shaded mesh, if bvh built for this mesh is given parts of mesh outside of view are skipped
+        void submit(IndexedMesh const &mesh, Matrix4x4 const &model, MeshBVH const *bvh = nullptr);
+
+        // Textured mesh, texture data must stay valid until flush
+        void submit(IndexedMesh const &mesh, Matrix4x4 const &model, Texture const &texture, MeshBVH const *bvh = nullptr);
+
+        // Every instance that can be visible - instances are culled by their boxes, parts of mesh by its BVH
+        // Shared mesh is transformed separately for every visible instance
+        void submit(MeshInstances const &instances);
+
+        // Textured instances, texture data must stay valid until flush
+        void submit(MeshInstances const &instances, Texture const &texture);
+
+        // Draws all triangles submitted since beginFrame
+        void flush();
+
+        // Triangles that were visible after culling and clipping in last frame
+        size_t getTriangleCount() const;
+
+    private:
+
+        // Screen is split into square tiles of this many cells that are drawn in parallel
+        static constexpr int tileSize = 32;
+
+        // Tiles drawn by different threads must not share tiles of depth buffer
+        static_assert(tileSize % DepthBuffer::tileSize == 0, "Renderer tiles must be made of depth buffer tiles");
+
+        // Meshes with less visible triangles are processed on calling thread
+        static constexpr size_t minParallelTriangles = 2048;
+
+        // Everything about mesh that is the same for all of its triangles
+        struct MeshJob {
+            IndexedMesh const *m_mesh;
+            Matrix4x4 m_modelViewProjection;
+            Vec3D m_cameraPosition;
+            Vec3D m_lightDirection;
+            int m_texture;
+            int m_numTasks;
+        };
+
+        void submitMesh(IndexedMesh const &mesh, Matrix4x4 const &model, Matrix4x4 const &modelInverse, int texture, MeshBVH const *bvh);
+
+        void submitInstances(MeshInstances const &instances, int texture);
+
+        // Vertices from first to first + count, different tasks must use different vertices
+        void transformVertices(MeshJob const &job, size_t first, size_t count);
+
+        // Culls, clips and projects triangles from first to first + count into given buffers
+        void processTriangles(MeshJob const &job, size_t first, size_t count, std::vector<TexturedTriangle> &triangles, std::vector<int> &triangleTextures) const;
+
+        // Projects clipped polygon to screen and splits it into triangles
+        void addPolygon(ClipVertex const *polygon, int count, Cell cell, int texture, std::vector<TexturedTriangle> &triangles, std::vector<int> &triangleTextures) const;
+
+        // Draws triangle with given index, only cells with minX <= x < maxX and minY <= y < maxY
+        void rasterize(uint32_t index, int minX, int minY, int maxX, int maxY);
+
+        // Deferred mode - writes cells of visible triangles in rectangle to render target
+        void resolve(int minX, int minY, int maxX, int maxY);
+
+        DepthMode m_depthMode = DepthMode::Painter;
+        std::vector<Cell> m_shadeRamp{ Cell{ 0x2588, 0x000F } };
+        Vec3D m_lightDirection{ 0.0f, 0.0f, -1.0f, 0.0f };
+        float m_ambient = 0.0f;
+
+        Camera const *m_camera = nullptr;
+        RenderTarget m_target{};
+
+        // Triangles hidden behind whole tiles of depth buffer are skipped without testing their cells
+        DepthBuffer m_depth;
+
+        // Deferred mode - closest triangle in every cell and its texture coordinates
+        std::vector<uint32_t> m_visibleTriangles;
+        std::vector<Vec2D> m_visibleTextures;
+
+        // Vertices of current mesh in clip space and planes each of them is outside of
+        VertexStream m_clipVertices;
+        std::vector<uint8_t> m_outcodes;
+        std::vector<uint8_t> m_guardOutcodes;
+        Clipper m_clipper;
+        std::vector<MeshBVH::Range> m_ranges;
+        // Vertices of m_ranges as sorted ranges that don't overlap, only vertex members are used
+        std::vector<MeshBVH::Range> m_vertexRanges;
+        std::vector<MeshInstances::Visible> m_visibleInstances;
+
+        // Triangles in screen space, texture index for each of them(-1 for flat)
+        std::vector<TexturedTriangle> m_triangles;
+        std::vector<int> m_triangleTextures;
+        std::vector<Texture> m_textures;
+
+        ParallelFor m_parallelFor;
+        int m_numThreads = 1;
+
+        // Output of every task when mesh is processed in parallel, joined to m_triangles in task order
+        std::vector<std::vector<TexturedTriangle>> m_taskTriangles;
+        std::vector<std::vector<int>> m_taskTriangleTextures;
+
+        // Positions in m_order of triangles touching tile, tiles of first task go first
+        std::vector<std::vector<uint32_t>> m_tileBins;
+        int m_tilesX = 0;
+        int m_tilesY = 0;
+
+        // Drawing order - triangles sorted by depth key computed once for each of them
+        std::vector<SortKey> m_order;
+        RadixSorter m_sorter;
+    };
+
+} // GE
@@ -0,0 +1,66 @@
+#pragma once
+
+// GE_SIMD is set by CMake option of the same name
+// SSE2 is present on every x64 CPU, other targets use scalar code
+#if defined(GE_SIMD) && (defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__))
+    #define GE_USE_SSE 1
+    #include <emmintrin.h>
+#endif
+
+namespace GE {
+
+#ifdef GE_USE_SSE
+
+    // Sum of x, y and z lanes placed in every lane
+    inline __m128 dot3(__m128 a, __m128 b) {
+        __m128 m = _mm_mul_ps(a, b);
+        __m128 y = _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 z = _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 2, 2, 2));
+        __m128 x = _mm_shuffle_ps(m, m, _MM_SHUFFLE(0, 0, 0, 0));
+        return _mm_add_ps(_mm_add_ps(x, y), z);
+    }
+
+    // Replaces w lane of v with value
+    inline __m128 setW(__m128 v, float value) {
+        __m128 zw = _mm_shuffle_ps(v, _mm_set_ss(value), _MM_SHUFFLE(0, 0, 2, 2)); // (z, z, w', w')
+        return _mm_shuffle_ps(v, zw, _MM_SHUFFLE(2, 0, 1, 0));                      // (x, y, z, w')
+    }
+
+    // Row vector v multiplied by matrix with rows r0-r3
+    inline __m128 transform4(__m128 v, __m128 r0, __m128 r1, __m128 r2, __m128 r3) {
+        __m128 sum = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r1));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+        return _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r3));
+    }
+
+    // Versions working with 16 byte aligned arrays of 4 floats
+    // Used by constexpr vector and matrix functions at runtime
+
+    inline float simdDot3(float const *a, float const *b) {
+        return _mm_cvtss_f32(dot3(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+
+    // (a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x, 1)
+    inline void simdCross3(float const *a, float const *b, float *out) {
+        __m128 va = _mm_load_ps(a);
+        __m128 vb = _mm_load_ps(b);
+        __m128 aYZX = _mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 bYZX = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 c = _mm_sub_ps(_mm_mul_ps(va, bYZX), _mm_mul_ps(aYZX, vb));
+        _mm_store_ps(out, setW(_mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1)), 1.0f));
+    }
+
+    // x, y and z divided by length, w is 1
+    inline void simdNormalize3(float const *a, float *out) {
+        __m128 v = _mm_load_ps(a);
+        _mm_store_ps(out, setW(_mm_div_ps(v, _mm_sqrt_ps(dot3(v, v))), 1.0f));
+    }
+
+    inline void simdTransform(float const *v, float const *r0, float const *r1, float const *r2, float const *r3, float *out) {
+        _mm_store_ps(out, transform4(_mm_load_ps(v), _mm_load_ps(r0), _mm_load_ps(r1), _mm_load_ps(r2), _mm_load_ps(r3)));
+    }
+
+#endif
+
+} // GE
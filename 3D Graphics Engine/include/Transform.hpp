@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Matrix4x4.hpp"
+
+namespace GE {
+
+    class Camera;
+
+    // Position, rotation and scale of an object
+    // Matrices are rebuilt only when something changed since last time they were requested
+    // Not thread safe - matrices are cached inside of getters
+    class Transform {
+    public:
+
+        void setPosition(Vec3D const &position);
+
+        void move(Vec3D const &offset);
+
+        Vec3D const &getPosition() const;
+
+        // Angles around X, Y and Z axises in radians
+        // Object is rotated around Z first, then around X and then around Y
+        void setRotation(float angleX, float angleY, float angleZ);
+
+        Vec3D const &getRotation() const;
+
+        void setScale(float x, float y, float z);
+
+        Vec3D const &getScale() const;
+
+        // Model matrix: scale, then rotation, then translation
+        Matrix4x4 const &getMatrix() const;
+
+        // Model matrix combined with view and projection of camera
+        // Recomputed only when transform or camera changed
+        Matrix4x4 const &getModelViewProjection(Camera const &camera) const;
+
+        // Increased every time transform changes
+        unsigned getVersion() const;
+
+    private:
+
+        void changed();
+
+        Vec3D m_position{ 0.0f, 0.0f, 0.0f };
+        Vec3D m_rotation{ 0.0f, 0.0f, 0.0f };
+        Vec3D m_scale{ 1.0f, 1.0f, 1.0f };
+
+        unsigned m_version = 1;
+
+        mutable Matrix4x4 m_matrix = Matrix4x4::getIdentity();
+        mutable bool m_matrixDirty = false;
+
+        mutable Matrix4x4 m_modelViewProjection{};
+        mutable Camera const *m_mvpCamera = nullptr;
+        mutable unsigned m_mvpCameraVersion = 0;
+        mutable unsigned m_mvpVersion = 0;
+    };
+
+} // GE
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "RenderTarget.hpp"
+#include "Triangle.hpp"
+#include <cmath>
+#include <utility>
+
+namespace GE {
+
+    // Walks cells of screen space triangles with perspective correct texture coordinates
+    // Triangle vertices are in cells, its texture coordinates hold u / w, v / w and 1 / w which change linearly on screen
+    // Coordinates are divided exactly only every subdivision cells of span and are stepped linearly in between
+    class TriangleRasterizer {
+    public:
+
+        static constexpr int subdivision = 16;
+
+        // Calls span(y, ax, bx, start, end) for every row of triangle between minY and maxY(excluded)
+        // start and end hold u / w, v / w and 1 / w at cells ax and bx, ax can be bigger than bx
+        template<typename SpanFn>
+        static void forEachSpan(TexturedTriangle const &triangle, int minY, int maxY, SpanFn &&span);
+
+        // Calls cell(x, u, v, depth) for cells from ax to bx(excluded) that are between minX and maxX(excluded)
+        // u and v are texture coordinates, depth is 1 / w
+        template<typename CellFn>
+        static void forEachCell(int ax, int bx, Vec2D start, Vec2D end, int minX, int maxX, CellFn &&cell);
+
+        // Textures triangle into target, if depth(1 / w for every cell of target) is given cells are depth tested
+        static void drawTextured(RenderTarget const &target, TexturedTriangle const &triangle, Texture const &texture, float *depth = nullptr);
+
+    };
+
+    template<typename SpanFn>
+    void TriangleRasterizer::forEachSpan(TexturedTriangle const &triangle, int minY, int maxY, SpanFn &&span) {
+        struct Corner {
+            int m_x, m_y;
+            Vec2D m_texture;
+        };
+        Corner c[3];
+        for (int i = 0; i < 3; ++i) {
+            // Corners can be outside of screen(inside of guard band), floor keeps negative cells consistent
+            c[i] = Corner{ static_cast<int>(std::floor(triangle.m_vertices[i].m_x)), static_cast<int>(std::floor(triangle.m_vertices[i].m_y)), triangle.m_textures[i] };
+        }
+
+        // Sort corners so y grows - triangle is drawn as flat bottom and flat top halves
+        if (c[1].m_y < c[0].m_y) std::swap(c[0], c[1]);
+        if (c[2].m_y < c[0].m_y) std::swap(c[0], c[2]);
+        if (c[2].m_y < c[1].m_y) std::swap(c[1], c[2]);
+
+        // Long side goes from first to last corner, short sides meet at middle corner
+        int dyLong = c[2].m_y - c[0].m_y;
+        float longStepX = 0.0f;
+        Vec2D longStep{ 0.0f, 0.0f, 0.0f };
+        if (dyLong) {
+            float inv = 1.0f / static_cast<float>(dyLong);
+            longStepX = static_cast<float>(c[2].m_x - c[0].m_x) * inv;
+            longStep = Vec2D{ (c[2].m_texture.m_u - c[0].m_texture.m_u) * inv, (c[2].m_texture.m_v - c[0].m_texture.m_v) * inv, (c[2].m_texture.m_w - c[0].m_texture.m_w) * inv };
+        }
+
+        for (int half = 0; half < 2; ++half) {
+            Corner const &from = c[half];
+            Corner const &to = c[half + 1];
+            int dy = to.m_y - from.m_y;
+            if (!dy) {
+                continue;
+            }
+            float inv = 1.0f / static_cast<float>(dy);
+            float stepX = static_cast<float>(to.m_x - from.m_x) * inv;
+            Vec2D step{ (to.m_texture.m_u - from.m_texture.m_u) * inv, (to.m_texture.m_v - from.m_texture.m_v) * inv, (to.m_texture.m_w - from.m_texture.m_w) * inv };
+
+            // Only rows between minY and maxY are drawn
+            int firstY = from.m_y > minY ? from.m_y : minY;
+            int lastY = to.m_y < maxY - 1 ? to.m_y : maxY - 1;
+            for (int y = firstY; y <= lastY; ++y) {
+                float i = static_cast<float>(y - from.m_y);
+                float l = static_cast<float>(y - c[0].m_y);
+                span(y,
+                    static_cast<int>(static_cast<float>(from.m_x) + i * stepX), static_cast<int>(static_cast<float>(c[0].m_x) + l * longStepX),
+                    Vec2D{ from.m_texture.m_u + i * step.m_u, from.m_texture.m_v + i * step.m_v, from.m_texture.m_w + i * step.m_w },
+                    Vec2D{ c[0].m_texture.m_u + l * longStep.m_u, c[0].m_texture.m_v + l * longStep.m_v, c[0].m_texture.m_w + l * longStep.m_w });
+            }
+        }
+    }
+
+    template<typename CellFn>
+    void TriangleRasterizer::forEachCell(int ax, int bx, Vec2D start, Vec2D end, int minX, int maxX, CellFn &&cell) {
+        if (ax > bx) {
+            std::swap(ax, bx);
+            std::swap(start, end);
+        }
+        int x = ax > minX ? ax : minX;
+        int last = bx < maxX ? bx : maxX;
+        if (x >= last) {
+            return;
+        }
+
+        // Attributes divided by w change by same amount every cell
+        float invLength = 1.0f / static_cast<float>(bx - ax);
+        float du = (end.m_u - start.m_u) * invLength;
+        float dv = (end.m_v - start.m_v) * invLength;
+        float dw = (end.m_w - start.m_w) * invLength;
+
+        // Parts are counted from start of span, so cells get same values for any minX and maxX
+        int part = ax + (x - ax) / subdivision * subdivision;
+        float offset = static_cast<float>(part - ax);
+        float w = start.m_w + offset * dw;
+        float u = (start.m_u + offset * du) / w;
+        float v = (start.m_v + offset * dv) / w;
+
+        while (x < last) {
+            int partEnd = part + subdivision < bx ? part + subdivision : bx;
+
+            // Exact texture coordinates at end of part, cells of part change linearly towards them
+            offset = static_cast<float>(partEnd - ax);
+            float wEnd = start.m_w + offset * dw;
+            float invWEnd = 1.0f / wEnd;
+            float uEnd = (start.m_u + offset * du) * invWEnd;
+            float vEnd = (start.m_v + offset * dv) * invWEnd;
+            float invCount = partEnd - part == subdivision ? 1.0f / subdivision : 1.0f / static_cast<float>(partEnd - part);
+            float stepU = (uEnd - u) * invCount;
+            float stepV = (vEnd - v) * invCount;
+
+            int cellsEnd = partEnd < last ? partEnd : last;
+            for (; x < cellsEnd; ++x) {
+                float i = static_cast<float>(x - part);
+                cell(x, u + i * stepU, v + i * stepV, w + i * dw);
+            }
+
+            part = partEnd;
+            w = wEnd;
+            u = uEnd;
+            v = vEnd;
+        }
+    }
+
+} // GE
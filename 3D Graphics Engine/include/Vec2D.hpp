@@ -1,6 +1,6 @@
 #pragma once
 
-#include <cmath>
+#include "MathUtils.hpp"
 
 namespace GE {
 
@@ -9,31 +9,72 @@ namespace GE {
         float m_v;
         float m_w = 1.0f; // Need for sensible matrix vector multiplication
 
-        Vec2D &operator+=(Vec2D const &rhs);
-
-        Vec2D &operator-=(Vec2D const &rhs);
-
-        Vec2D &operator*=(float val);
-
-        Vec2D &operator/=(float val);
-
-        float dotProduct(Vec2D const &rhs) const;
-
-        float length() const;
-
-        Vec2D getNormalized() const;
-
-        Vec2D &normalize();
+        constexpr Vec2D &operator+=(Vec2D const &rhs) {
+            m_u += rhs.m_u;
+            m_v += rhs.m_v;
+            return *this;
+        }
+
+        constexpr Vec2D &operator-=(Vec2D const &rhs) {
+            m_u -= rhs.m_u;
+            m_v -= rhs.m_v;
+            return *this;
+        }
+
+        constexpr Vec2D &operator*=(float val) {
+            m_u *= val;
+            m_v *= val;
+            return *this;
+        }
+
+        constexpr Vec2D &operator/=(float val) {
+            m_u /= val;
+            m_v /= val;
+            return *this;
+        }
+
+        constexpr float dotProduct(Vec2D const &rhs) const {
+            return m_u * rhs.m_u + m_v * rhs.m_v;
+        }
+
+        constexpr float length() const {
+            return squareRoot(dotProduct(*this));
+        }
+
+        constexpr Vec2D getNormalized() const {
+            float l = length();
+            return Vec2D{ m_u / l, m_v / l };
+        }
+
+        constexpr Vec2D &normalize() {
+            *this = getNormalized();
+            return *this;
+        }
     };
 
-    Vec2D operator+(Vec2D lhs, Vec2D const &rhs);
+    constexpr Vec2D operator+(Vec2D lhs, Vec2D const &rhs) {
+        lhs += rhs;
+        return lhs;
+    }
 
-    Vec2D operator-(Vec2D lhs, Vec2D const &rhs);
+    constexpr Vec2D operator-(Vec2D lhs, Vec2D const &rhs) {
+        lhs -= rhs;
+        return lhs;
+    }
 
-    Vec2D operator*(Vec2D lhs, float val);
+    constexpr Vec2D operator*(Vec2D lhs, float val) {
+        lhs *= val;
+        return lhs;
+    }
 
-    Vec2D operator*(float val, Vec2D rhs);
+    constexpr Vec2D operator*(float val, Vec2D rhs) {
+        rhs *= val;
+        return rhs;
+    }
 
-    Vec2D operator/(Vec2D lhs, float val);
+    constexpr Vec2D operator/(Vec2D lhs, float val) {
+        lhs /= val;
+        return lhs;
+    }
 
-} // GE
\ No newline at end of file
+} // GE
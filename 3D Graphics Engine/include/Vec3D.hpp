@@ -1,43 +1,115 @@
 #pragma once
 
-#include <cmath>
+#include "MathUtils.hpp"
+#include "SIMD.hpp"
 
 namespace GE {
 
-    struct Vec3D {
+    // Aligned to 16 bytes so all 4 components can be loaded into one SIMD register
+    // All operations are constexpr, at runtime SIMD versions are used when available
+    struct alignas(16) Vec3D {
         float m_x;
         float m_y;
         float m_z;
         float m_w = 1.0f; // Need for sensible matrix vector multiplication
 
-        Vec3D &operator+=(Vec3D const &rhs);
-
-        Vec3D &operator-=(Vec3D const &rhs);
-
-        Vec3D &operator*=(float val);
-
-        Vec3D &operator/=(float val);
-
-        float dotProduct(Vec3D const &rhs) const;
-
-        Vec3D crossProduct(Vec3D const &rhs) const;
-
-        float length() const;
-
-        Vec3D getNormalized() const;
-
-        Vec3D &normalize();
+        constexpr Vec3D &operator+=(Vec3D const &rhs) {
+            m_x += rhs.m_x;
+            m_y += rhs.m_y;
+            m_z += rhs.m_z;
+            return *this;
+        }
+
+        constexpr Vec3D &operator-=(Vec3D const &rhs) {
+            m_x -= rhs.m_x;
+            m_y -= rhs.m_y;
+            m_z -= rhs.m_z;
+            return *this;
+        }
+
+        constexpr Vec3D &operator*=(float val) {
+            m_x *= val;
+            m_y *= val;
+            m_z *= val;
+            return *this;
+        }
+
+        constexpr Vec3D &operator/=(float val) {
+            m_x /= val;
+            m_y /= val;
+            m_z /= val;
+            return *this;
+        }
+
+        constexpr float dotProduct(Vec3D const &rhs) const {
+#ifdef GE_USE_SSE
+            if (!GE_CONSTANT_EVALUATED()) {
+                return simdDot3(&m_x, &rhs.m_x);
+            }
+#endif
+            return m_x * rhs.m_x + m_y * rhs.m_y + m_z * rhs.m_z;
+        }
+
+        constexpr Vec3D crossProduct(Vec3D const &rhs) const {
+#ifdef GE_USE_SSE
+            if (!GE_CONSTANT_EVALUATED()) {
+                Vec3D res{};
+                simdCross3(&m_x, &rhs.m_x, &res.m_x);
+                return res;
+            }
+#endif
+            float cx = m_y * rhs.m_z - m_z * rhs.m_y;
+            float cy = m_z * rhs.m_x - m_x * rhs.m_z;
+            float cz = m_x * rhs.m_y - m_y * rhs.m_x;
+            return Vec3D{ cx, cy, cz };
+        }
+
+        constexpr float length() const {
+            return squareRoot(dotProduct(*this));
+        }
+
+        constexpr Vec3D getNormalized() const {
+#ifdef GE_USE_SSE
+            if (!GE_CONSTANT_EVALUATED()) {
+                Vec3D res{};
+                simdNormalize3(&m_x, &res.m_x);
+                return res;
+            }
+#endif
+            float l = length();
+            return Vec3D{ m_x / l, m_y / l, m_z / l };
+        }
+
+        constexpr Vec3D &normalize() {
+            *this = getNormalized();
+            return *this;
+        }
     };
 
-    Vec3D operator+(Vec3D lhs, Vec3D const &rhs);
-
-    Vec3D operator-(Vec3D lhs, Vec3D const &rhs);
-
-    Vec3D operator*(Vec3D lhs, float val);
-
-    Vec3D operator*(float val, Vec3D rhs);
-
-    Vec3D operator/(Vec3D lhs, float val);
+    constexpr Vec3D operator+(Vec3D lhs, Vec3D const &rhs) {
+        lhs += rhs;
+        return lhs;
+    }
+
+    constexpr Vec3D operator-(Vec3D lhs, Vec3D const &rhs) {
+        lhs -= rhs;
+        return lhs;
+    }
+
+    constexpr Vec3D operator*(Vec3D lhs, float val) {
+        lhs *= val;
+        return lhs;
+    }
+
+    constexpr Vec3D operator*(float val, Vec3D rhs) {
+        rhs *= val;
+        return rhs;
+    }
+
+    constexpr Vec3D operator/(Vec3D lhs, float val) {
+        lhs /= val;
+        return lhs;
+    }
 
 } // GE
 
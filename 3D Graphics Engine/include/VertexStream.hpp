@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Vec3D.hpp"
+#include <vector>
+
+namespace GE {
+
+    // Vertices stored as structure of arrays - every component has its own array
+    // Batch transform loads 4 or 8 vertices at once from such arrays
+    struct VertexStream {
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_z;
+        std::vector<float> m_w;
+
+        void resize(size_t count);
+
+        size_t size() const;
+
+        void set(size_t index, Vec3D const &v);
+
+        Vec3D get(size_t index) const;
+    };
+
+} // GE
@@ -0,0 +1,41 @@
+#include "AABB.hpp"
+
+namespace GE {
+
+    bool AABB::isEmpty() const {
+        return m_min.m_x > m_max.m_x || m_min.m_y > m_max.m_y || m_min.m_z > m_max.m_z;
+    }
+
+    void AABB::extend(Vec3D const &point) {
+        m_min.m_x = point.m_x < m_min.m_x ? point.m_x : m_min.m_x;
+        m_min.m_y = point.m_y < m_min.m_y ? point.m_y : m_min.m_y;
+        m_min.m_z = point.m_z < m_min.m_z ? point.m_z : m_min.m_z;
+        m_max.m_x = point.m_x > m_max.m_x ? point.m_x : m_max.m_x;
+        m_max.m_y = point.m_y > m_max.m_y ? point.m_y : m_max.m_y;
+        m_max.m_z = point.m_z > m_max.m_z ? point.m_z : m_max.m_z;
+    }
+
+    void AABB::extend(AABB const &box) {
+        if (!box.isEmpty()) {
+            extend(box.m_min);
+            extend(box.m_max);
+        }
+    }
+
+    Vec3D AABB::getCenter() const {
+        return (m_min + m_max) * 0.5f;
+    }
+
+    Vec3D AABB::getExtents() const {
+        return (m_max - m_min) * 0.5f;
+    }
+
+    AABB AABB::fromStream(VertexStream const &vertices) {
+        AABB box;
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            box.extend(Vec3D{ vertices.m_x[i], vertices.m_y[i], vertices.m_z[i] });
+        }
+        return box;
+    }
+
+} // GE
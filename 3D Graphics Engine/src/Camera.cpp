@@ -0,0 +1,106 @@
+#include "Camera.hpp"
+
+namespace GE {
+
+    Camera::Camera(float fovDegrees, float aspectRatio, float zNear, float zFar) {
+        setProjection(fovDegrees, aspectRatio, zNear, zFar);
+    }
+
+    void Camera::setProjection(float fovDegrees, float aspectRatio, float zNear, float zFar) {
+        m_projection = Matrix4x4::makeProjection(fovDegrees, aspectRatio, zNear, zFar);
+        m_zNear = zNear;
+        m_zFar = zFar;
+        m_viewProjectionDirty = true;
+        ++m_version;
+    }
+
+    float Camera::getNear() const {
+        return m_zNear;
+    }
+
+    float Camera::getFar() const {
+        return m_zFar;
+    }
+
+    void Camera::setPosition(Vec3D const &position) {
+        m_position = position;
+        viewChanged();
+    }
+
+    void Camera::move(Vec3D const &offset) {
+        m_position += offset;
+        viewChanged();
+    }
+
+    Vec3D const &Camera::getPosition() const {
+        return m_position;
+    }
+
+    void Camera::setYaw(float angleRad) {
+        m_yaw = angleRad;
+        viewChanged();
+    }
+
+    float Camera::getYaw() const {
+        return m_yaw;
+    }
+
+    void Camera::setPitch(float angleRad) {
+        m_pitch = angleRad;
+        viewChanged();
+    }
+
+    float Camera::getPitch() const {
+        return m_pitch;
+    }
+
+    Vec3D const &Camera::getLookDirection() const {
+        update();
+        return m_lookDir;
+    }
+
+    Matrix4x4 const &Camera::getView() const {
+        update();
+        return m_view;
+    }
+
+    Matrix4x4 const &Camera::getProjection() const {
+        return m_projection;
+    }
+
+    Matrix4x4 const &Camera::getViewProjection() const {
+        update();
+        return m_viewProjection;
+    }
+
+    unsigned Camera::getVersion() const {
+        return m_version;
+    }
+
+    void Camera::viewChanged() {
+        m_viewDirty = true;
+        m_viewProjectionDirty = true;
+        ++m_version;
+    }
+
+    void Camera::update() const {
+        if (m_viewDirty) {
+            // Our up is same as Y axis
+            Vec3D upVec{ 0.0f, 1.0f, 0.0f };
+
+            // Default direction camera looks at is +Z, it's turned up or down and then left or right
+            Matrix4x4 cameraRotation = Matrix4x4::makeRotationX(m_pitch).multiplyMatrix(Matrix4x4::makeRotationY(m_yaw));
+            m_lookDir = cameraRotation.multiplyVector(Vec3D{ 0.0f, 0.0f, 1.0f });
+
+            // We dont actually rotate camera in the world - we rotate world around camera
+            // so view matrix is inverse of matrix that places camera in the world
+            m_view = Matrix4x4::makePointAt(m_position, m_position + m_lookDir, upVec).getQuickInverse();
+            m_viewDirty = false;
+        }
+        if (m_viewProjectionDirty) {
+            m_viewProjection = m_view.multiplyMatrix(m_projection);
+            m_viewProjectionDirty = false;
+        }
+    }
+
+} // GE
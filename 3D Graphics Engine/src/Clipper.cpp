@@ -0,0 +1,87 @@
+#include "Clipper.hpp"
+
+namespace GE {
+
+    Clipper::Clipper(float guardBand)
+        : m_guardBand(guardBand) {
+    }
+
+    // Plane bit if condition is true, both results have same type so enum doesn't mix with 0
+    static uint32_t planeIf(bool condition, uint32_t plane) {
+        return condition ? plane : 0u;
+    }
+
+    uint32_t Clipper::getOutcode(Vec3D const &p) const {
+        return planeIf(p.m_x < -p.m_w, Left) | planeIf(p.m_x > p.m_w, Right) |
+               planeIf(p.m_y < -p.m_w, Bottom) | planeIf(p.m_y > p.m_w, Top) |
+               planeIf(p.m_z < 0.0f, Near) | planeIf(p.m_z > p.m_w, Far);
+    }
+
+    uint32_t Clipper::getGuardOutcode(Vec3D const &p) const {
+        float g = m_guardBand * p.m_w;
+        return planeIf(p.m_x < -g, Left) | planeIf(p.m_x > g, Right) |
+               planeIf(p.m_y < -g, Bottom) | planeIf(p.m_y > g, Top);
+    }
+
+    uint32_t Clipper::getClipPlanes(uint32_t const codes[3], uint32_t const guardCodes[3], bool &rejected) const {
+        rejected = (codes[0] & codes[1] & codes[2]) != 0;
+        // Near and far planes are always exact, side planes only if triangle leaves guard band
+        return ((codes[0] | codes[1] | codes[2]) & (Near | Far)) | guardCodes[0] | guardCodes[1] | guardCodes[2];
+    }
+
+    // Signed distance to plane - positive inside, side planes are at edges of guard band
+    float Clipper::getDistance(Vec3D const &p, uint32_t plane) const {
+        float g = m_guardBand * p.m_w;
+        switch (plane) {
+        case Left:   return p.m_x + g;
+        case Right:  return g - p.m_x;
+        case Bottom: return p.m_y + g;
+        case Top:    return g - p.m_y;
+        case Near:   return p.m_z;
+        default:     return p.m_w - p.m_z;
+        }
+    }
+
+    int Clipper::clipTriangle(ClipVertex const in[3], uint32_t planes, ClipVertex *out) const {
+        ClipVertex buffers[2][maxVertices];
+        ClipVertex const *src = in;
+        int count = 3;
+        int target = 0;
+
+        for (uint32_t plane = Left; plane <= Far && count >= 3; plane <<= 1) {
+            if (!(planes & plane)) {
+                continue;
+            }
+            ClipVertex *dst = buffers[target];
+            int numOut = 0;
+
+            // Every edge keeps its start if it is inside and adds point where it crosses plane
+            float startDistance = getDistance(src[count - 1].m_position, plane);
+            for (int i = 0; i < count; ++i) {
+                ClipVertex const &start = src[(i + count - 1) % count];
+                ClipVertex const &end = src[i];
+                float endDistance = getDistance(end.m_position, plane);
+                if (startDistance >= 0.0f) {
+                    dst[numOut++] = start;
+                }
+                if ((startDistance >= 0.0f) != (endDistance >= 0.0f)) {
+                    float t = startDistance / (startDistance - endDistance);
+                    ClipVertex &v = dst[numOut++];
+                    v.m_position = start.m_position + (end.m_position - start.m_position) * t;
+                    v.m_position.m_w = start.m_position.m_w + (end.m_position.m_w - start.m_position.m_w) * t;
+                    v.m_texture = start.m_texture + t * (end.m_texture - start.m_texture);
+                }
+                startDistance = endDistance;
+            }
+            src = dst;
+            count = numOut;
+            target ^= 1;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            out[i] = src[i];
+        }
+        return count;
+    }
+
+} // GE
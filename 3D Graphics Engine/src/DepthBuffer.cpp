@@ -0,0 +1,91 @@
+#include "DepthBuffer.hpp"
+
+namespace GE {
+
+    void DepthBuffer::resize(int width, int height) {
+        m_width = width;
+        m_height = height;
+        m_tilesX = (width + tileSize - 1) / tileSize;
+        m_tilesY = (height + tileSize - 1) / tileSize;
+        m_depth.resize(static_cast<size_t>(width) * height);
+        m_tiles.resize(static_cast<size_t>(m_tilesX) * m_tilesY);
+    }
+
+    void DepthBuffer::clear() {
+        for (Tile &tile : m_tiles) {
+            tile = Tile{ 0.0f, 0.0f, true, 0 };
+        }
+    }
+
+    int DepthBuffer::getWidth() const {
+        return m_width;
+    }
+
+    int DepthBuffer::getHeight() const {
+        return m_height;
+    }
+
+    DepthBuffer::Visibility DepthBuffer::test(int minX, int minY, int maxX, int maxY, float nearest, float farthest) {
+        bool occluded = true;
+        bool visible = true;
+        for (int ty = minY / tileSize; ty <= (maxY - 1) / tileSize; ++ty) {
+            for (int tx = minX / tileSize; tx <= (maxX - 1) / tileSize; ++tx) {
+                Tile &tile = m_tiles[ty * m_tilesX + tx];
+
+                // Farthest depth only grows when cells are written, it is found again only if answer can change
+                // and enough triangles were drawn to tile since last time, so scanning cost is shared by them
+                if (tile.m_writes >= rescanWrites && nearest >= tile.m_farthest && nearest < tile.m_nearest) {
+                    updateFarthest(tx, ty);
+                }
+                occluded = occluded && nearest < tile.m_farthest;
+                visible = visible && farthest > tile.m_nearest;
+            }
+        }
+        return occluded ? Visibility::Occluded : (visible ? Visibility::Visible : Visibility::Partial);
+    }
+
+    void DepthBuffer::beginWrite(int minX, int minY, int maxX, int maxY, float nearest) {
+        for (int ty = minY / tileSize; ty <= (maxY - 1) / tileSize; ++ty) {
+            for (int tx = minX / tileSize; tx <= (maxX - 1) / tileSize; ++tx) {
+                Tile &tile = m_tiles[ty * m_tilesX + tx];
+                if (tile.m_cleared) {
+                    int lastX = (tx + 1) * tileSize < m_width ? (tx + 1) * tileSize : m_width;
+                    int lastY = (ty + 1) * tileSize < m_height ? (ty + 1) * tileSize : m_height;
+                    for (int y = ty * tileSize; y < lastY; ++y) {
+                        float *row = &m_depth[static_cast<size_t>(y) * m_width];
+                        for (int x = tx * tileSize; x < lastX; ++x) {
+                            row[x] = 0.0f;
+                        }
+                    }
+                    tile.m_cleared = false;
+                }
+                tile.m_nearest = nearest > tile.m_nearest ? nearest : tile.m_nearest;
+                ++tile.m_writes;
+            }
+        }
+    }
+
+    bool DepthBuffer::isTileCleared(int tx, int ty) const {
+        return m_tiles[ty * m_tilesX + tx].m_cleared;
+    }
+
+    float *DepthBuffer::getData() {
+        return m_depth.data();
+    }
+
+    void DepthBuffer::updateFarthest(int tx, int ty) {
+        int lastX = (tx + 1) * tileSize < m_width ? (tx + 1) * tileSize : m_width;
+        int lastY = (ty + 1) * tileSize < m_height ? (ty + 1) * tileSize : m_height;
+        float farthest = m_depth[static_cast<size_t>(ty) * tileSize * m_width + tx * tileSize];
+        for (int y = ty * tileSize; y < lastY; ++y) {
+            float const *row = &m_depth[static_cast<size_t>(y) * m_width];
+            for (int x = tx * tileSize; x < lastX; ++x) {
+                farthest = row[x] < farthest ? row[x] : farthest;
+            }
+        }
+        Tile &tile = m_tiles[ty * m_tilesX + tx];
+        tile.m_farthest = farthest;
+        tile.m_writes = 0;
+    }
+
+} // GE
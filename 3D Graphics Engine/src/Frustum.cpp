@@ -0,0 +1,55 @@
+#include "Frustum.hpp"
+
+namespace GE {
+
+    float Plane::getDistance(Vec3D const &point) const {
+        return m_normal.m_x * point.m_x + m_normal.m_y * point.m_y + m_normal.m_z * point.m_z + m_d;
+    }
+
+    Frustum Frustum::fromMatrix(Matrix4x4 const &m) {
+        // Vectors are multiplied as rows so clip space x is dot product with column 0, w with column 3
+        auto column = [&m](int col) {
+            return Plane{ Vec3D{ m[0][col], m[1][col], m[2][col] }, m[3][col] };
+        };
+        auto add = [](Plane const &a, Plane const &b, float sign) {
+            return Plane{ Vec3D{ a.m_normal.m_x + sign * b.m_normal.m_x, a.m_normal.m_y + sign * b.m_normal.m_y, a.m_normal.m_z + sign * b.m_normal.m_z }, a.m_d + sign * b.m_d };
+        };
+
+        // -w <= x <= w, -w <= y <= w, 0 <= z <= w
+        // Planes are not normalized - only sign of distance is used
+        Plane x = column(0), y = column(1), z = column(2), w = column(3);
+        Frustum frustum;
+        frustum.m_planes[0] = add(w, x, 1.0f);
+        frustum.m_planes[1] = add(w, x, -1.0f);
+        frustum.m_planes[2] = add(w, y, 1.0f);
+        frustum.m_planes[3] = add(w, y, -1.0f);
+        frustum.m_planes[4] = z;
+        frustum.m_planes[5] = add(w, z, -1.0f);
+        return frustum;
+    }
+
+    Frustum::Containment Frustum::test(AABB const &box) const {
+        Containment res = Containment::Inside;
+        for (Plane const &plane : m_planes) {
+            // Corners of box that are farthest in front of plane and farthest behind it
+            Vec3D front{
+                plane.m_normal.m_x >= 0.0f ? box.m_max.m_x : box.m_min.m_x,
+                plane.m_normal.m_y >= 0.0f ? box.m_max.m_y : box.m_min.m_y,
+                plane.m_normal.m_z >= 0.0f ? box.m_max.m_z : box.m_min.m_z
+            };
+            Vec3D back{
+                plane.m_normal.m_x >= 0.0f ? box.m_min.m_x : box.m_max.m_x,
+                plane.m_normal.m_y >= 0.0f ? box.m_min.m_y : box.m_max.m_y,
+                plane.m_normal.m_z >= 0.0f ? box.m_min.m_z : box.m_max.m_z
+            };
+            if (plane.getDistance(front) < 0.0f) {
+                return Containment::Outside;
+            }
+            if (plane.getDistance(back) < 0.0f) {
+                res = Containment::Intersects;
+            }
+        }
+        return res;
+    }
+
+} // GE
@@ -0,0 +1,125 @@
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+    #define NOMINMAX
+    #include <Windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace GE {
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+#ifdef _WIN32
+
+    bool MappedFile::open(std::string const &path) {
+        close();
+
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        m_file = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            close();
+            return false;
+        }
+        m_size = static_cast<size_t>(size.QuadPart);
+
+        // Empty file can't be mapped but is still valid
+        if (m_size == 0) {
+            return true;
+        }
+
+        m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping) {
+            close();
+            return false;
+        }
+
+        m_data = static_cast<char const *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_data) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+        if (m_file) {
+            CloseHandle(m_file);
+        }
+        m_file = nullptr;
+        m_mapping = nullptr;
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+#else
+
+    bool MappedFile::open(std::string const &path) {
+        close();
+
+        m_fd = ::open(path.c_str(), O_RDONLY);
+        if (m_fd < 0) {
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(m_fd, &info) != 0) {
+            close();
+            return false;
+        }
+        m_size = static_cast<size_t>(info.st_size);
+
+        // Empty file can't be mapped but is still valid
+        if (m_size == 0) {
+            return true;
+        }
+
+        void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (data == MAP_FAILED) {
+            close();
+            return false;
+        }
+        m_data = static_cast<char const *>(data);
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (m_data) {
+            munmap(const_cast<char *>(m_data), m_size);
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+        m_fd = -1;
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+#endif
+
+    char const *MappedFile::data() const {
+        return m_data;
+    }
+
+    size_t MappedFile::size() const {
+        return m_size;
+    }
+
+} // GE
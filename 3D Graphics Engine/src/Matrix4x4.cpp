@@ -1,100 +1,121 @@
 #include "Matrix4x4.hpp"
+#include "SIMD.hpp"
 
-namespace GE {
-
-    Matrix4x4::Row &Matrix4x4::operator[](int index) {
-        return m_rows.at(index);
-    }
-
-    Matrix4x4::Row const &Matrix4x4::operator[](int index) const {
-        return m_rows.at(index);
-    }
-
-    float &Matrix4x4::Row::operator[](int index) {
-        return m_vals.at(index);
-    }
-
-    float Matrix4x4::Row::operator[](int index) const {
-        return m_vals.at(index);
-    }
+#if defined(GE_USE_SSE) && defined(__AVX__)
+    #include <immintrin.h>
+#endif
 
-    Vec3D Matrix4x4::multiplyVector(Vec3D const &v) const {
-        Vec3D res;
-        res.m_x = v.m_x * (*this)[0][0] + v.m_y * (*this)[1][0] + v.m_z * (*this)[2][0] + v.m_w * (*this)[3][0];
-        res.m_y = v.m_x * (*this)[0][1] + v.m_y * (*this)[1][1] + v.m_z * (*this)[2][1] + v.m_w * (*this)[3][1];
-        res.m_z = v.m_x * (*this)[0][2] + v.m_y * (*this)[1][2] + v.m_z * (*this)[2][2] + v.m_w * (*this)[3][2];
-        res.m_w = v.m_x * (*this)[0][3] + v.m_y * (*this)[1][3] + v.m_z * (*this)[2][3] + v.m_w * (*this)[3][3];
-        return res;
-    }
+namespace GE {
 
-    Matrix4x4 Matrix4x4::multiplyMatrix(Matrix4x4 const &v) const {
-        Matrix4x4 res{};
-        for (int c = 0; c < 4; ++c) {
-            for (int r = 0; r < 4; ++r) {
-                res[r][c] = (*this)[r][0] * v[0][c] + (*this)[r][1] * v[1][c] + (*this)[r][2] * v[2][c] + (*this)[r][3] * v[3][c];
+    void Matrix4x4::multiplyVectors(Vec3D const *in, Vec3D *out, size_t count, bool perspectiveDivide) const {
+#ifdef GE_USE_SSE
+        // Rows are loaded once for whole batch
+        __m128 r0 = _mm_load_ps(m_rows[0].data());
+        __m128 r1 = _mm_load_ps(m_rows[1].data());
+        __m128 r2 = _mm_load_ps(m_rows[2].data());
+        __m128 r3 = _mm_load_ps(m_rows[3].data());
+        for (size_t i = 0; i < count; ++i) {
+            __m128 sum = transform4(_mm_load_ps(&in[i].m_x), r0, r1, r2, r3);
+            if (perspectiveDivide) {
+                __m128 w = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(3, 3, 3, 3));
+                sum = setW(_mm_div_ps(sum, w), _mm_cvtss_f32(w));
             }
+            _mm_store_ps(&out[i].m_x, sum);
         }
-        return res;
-    }
-
-    Matrix4x4 Matrix4x4::getIdentity() {
-        Matrix4x4 m{};
-        for (int i = 0; i < 4; ++i) {
-            m[i][i] = 1.0f;
+#else
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = multiplyVector(in[i]);
+            if (perspectiveDivide) {
+                out[i] /= out[i].m_w;
+            }
         }
-        return m;
-    }
-
-    Matrix4x4 Matrix4x4::makeRotationX(float angleRad) {
-        Matrix4x4 rotX{};
-        rotX[0][0] =  1.0f;
-        rotX[1][1] =  std::cosf(angleRad);
-        rotX[1][2] = -std::sinf(angleRad);
-        rotX[2][1] =  std::sinf(angleRad);
-        rotX[2][2] =  std::cosf(angleRad);
-        rotX[3][3] =  1.0f;
-        return rotX;
+#endif
     }
 
-    Matrix4x4 Matrix4x4::makeRotationY(float angleRad) {
-        Matrix4x4 rotY{};
-        rotY[0][0] =  std::cosf(angleRad);
-        rotY[0][2] =  std::sinf(angleRad);
-        rotY[2][0] = -std::sinf(angleRad);
-        rotY[1][1] =  1.0f;
-        rotY[2][2] =  std::cosf(angleRad);
-        rotY[3][3] =  1.0f;
-        return rotY;
+    void Matrix4x4::multiplyStream(VertexStream const &in, VertexStream &out, bool perspectiveDivide) const {
+        out.resize(in.size());
+        multiplyStream(in, out, 0, in.size(), perspectiveDivide);
     }
 
-    Matrix4x4 Matrix4x4::makeRotationZ(float angleRad) {
-        Matrix4x4 rotZ{};
-        rotZ[0][0] =  std::cosf(angleRad);
-        rotZ[0][1] = -std::sinf(angleRad);
-        rotZ[1][0] =  std::sinf(angleRad);
-        rotZ[1][1] =  std::cosf(angleRad);
-        rotZ[2][2] =  1.0f;
-        rotZ[3][3] =  1.0f;
-        return rotZ;
-    }
-
-    Matrix4x4 Matrix4x4::makeTranslation(float x, float y, float z) {
-        Matrix4x4 trans = Matrix4x4::getIdentity();
-        trans[3][0] = x;
-        trans[3][1] = y;
-        trans[3][2] = z;
-        return trans;
-    }
-
-    Matrix4x4 Matrix4x4::makeProjection(float fovDegrees, float aspectRatio, float zNear, float zFar) {
-        float fovRad = 1 / std::tanf(fovDegrees * 0.5f / 180.0f * 3.14159f);
-        Matrix4x4 proj{};
-        proj[0][0] = aspectRatio * fovRad;
-        proj[1][1] = fovRad;
-        proj[2][2] = zFar / (zFar - zNear);
-        proj[3][2] = (-zNear * zFar) / (zFar - zNear);
-        proj[2][3] = 1.0f;
-        return proj;
+    void Matrix4x4::multiplyStream(VertexStream const &in, VertexStream &out, size_t first, size_t count, bool perspectiveDivide) const {
+        float const *ix = in.m_x.data() + first, *iy = in.m_y.data() + first, *iz = in.m_z.data() + first, *iw = in.m_w.data() + first;
+        float *ox = out.m_x.data() + first, *oy = out.m_y.data() + first, *oz = out.m_z.data() + first, *ow = out.m_w.data() + first;
+        Matrix4x4 const &m = *this;
+        size_t i = 0;
+#if defined(GE_USE_SSE) && defined(__AVX__)
+        // 8 vertices per iteration, every matrix element is broadcast to all lanes
+        __m256 c[4][4];
+        for (int r = 0; r < 4; ++r) {
+            for (int col = 0; col < 4; ++col) {
+                c[r][col] = _mm256_set1_ps(m[r][col]);
+            }
+        }
+        for (; i + 8 <= count; i += 8) {
+            __m256 x = _mm256_loadu_ps(ix + i), y = _mm256_loadu_ps(iy + i), z = _mm256_loadu_ps(iz + i), w = _mm256_loadu_ps(iw + i);
+            __m256 res[4];
+            for (int col = 0; col < 4; ++col) {
+                res[col] = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(x, c[0][col]), _mm256_mul_ps(y, c[1][col])),
+                    _mm256_add_ps(_mm256_mul_ps(z, c[2][col]), _mm256_mul_ps(w, c[3][col]))
+                );
+            }
+            if (perspectiveDivide) {
+                __m256 invW = _mm256_div_ps(_mm256_set1_ps(1.0f), res[3]);
+                res[0] = _mm256_mul_ps(res[0], invW);
+                res[1] = _mm256_mul_ps(res[1], invW);
+                res[2] = _mm256_mul_ps(res[2], invW);
+            }
+            _mm256_storeu_ps(ox + i, res[0]);
+            _mm256_storeu_ps(oy + i, res[1]);
+            _mm256_storeu_ps(oz + i, res[2]);
+            _mm256_storeu_ps(ow + i, res[3]);
+        }
+#elif defined(GE_USE_SSE)
+        // 4 vertices per iteration, every matrix element is broadcast to all lanes
+        __m128 c[4][4];
+        for (int r = 0; r < 4; ++r) {
+            for (int col = 0; col < 4; ++col) {
+                c[r][col] = _mm_set1_ps(m[r][col]);
+            }
+        }
+        for (; i + 4 <= count; i += 4) {
+            __m128 x = _mm_loadu_ps(ix + i), y = _mm_loadu_ps(iy + i), z = _mm_loadu_ps(iz + i), w = _mm_loadu_ps(iw + i);
+            __m128 res[4];
+            for (int col = 0; col < 4; ++col) {
+                res[col] = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(x, c[0][col]), _mm_mul_ps(y, c[1][col])),
+                    _mm_add_ps(_mm_mul_ps(z, c[2][col]), _mm_mul_ps(w, c[3][col]))
+                );
+            }
+            if (perspectiveDivide) {
+                __m128 invW = _mm_div_ps(_mm_set1_ps(1.0f), res[3]);
+                res[0] = _mm_mul_ps(res[0], invW);
+                res[1] = _mm_mul_ps(res[1], invW);
+                res[2] = _mm_mul_ps(res[2], invW);
+            }
+            _mm_storeu_ps(ox + i, res[0]);
+            _mm_storeu_ps(oy + i, res[1]);
+            _mm_storeu_ps(oz + i, res[2]);
+            _mm_storeu_ps(ow + i, res[3]);
+        }
+#endif
+        // Vertices left after last full batch
+        for (; i < count; ++i) {
+            float x = ix[i], y = iy[i], z = iz[i], w = iw[i];
+            float rx = x * m[0][0] + y * m[1][0] + z * m[2][0] + w * m[3][0];
+            float ry = x * m[0][1] + y * m[1][1] + z * m[2][1] + w * m[3][1];
+            float rz = x * m[0][2] + y * m[1][2] + z * m[2][2] + w * m[3][2];
+            float rw = x * m[0][3] + y * m[1][3] + z * m[2][3] + w * m[3][3];
+            if (perspectiveDivide) {
+                rx /= rw;
+                ry /= rw;
+                rz /= rw;
+            }
+            ox[i] = rx;
+            oy[i] = ry;
+            oz[i] = rz;
+            ow[i] = rw;
+        }
     }
 
 } // GE
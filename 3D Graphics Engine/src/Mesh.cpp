@@ -1,130 +1,215 @@
 #include "Mesh.hpp"
+#include "ObjParser.hpp"
+#include <cstring>
+#include <unordered_map>
 
 namespace GE {
 
+    // Texture vertex of corner, v is flipped because .obj has it going up
+    static Vec2D getObjTexture(ObjData const &data, int32_t index) {
+        if (index < 0) {
+            return Vec2D{ 0.0f, 0.0f };
+        }
+        Vec2D v = data.m_textures[index];
+        v.m_v = 1.0f - v.m_v;
+        return v;
+    }
+
     bool Mesh::loadFromFile(std::string const &path) {
 
-        std::ifstream f(path);
-        if (!f.is_open()) {
+        ObjData data;
+        if (!ObjParser::parseFile(path, data)) {
             return false;
         }
 
-        // Buffer in which lines of file are read
-        std::string buf;
-
-        // Local cache of vertices
-        std::vector<Vec3D> verts;
-
-        while (std::getline(f, buf)) {
-            if (buf.empty()) {
-                continue;
-            }
-
-            // String stream to parse input from buffer
-            std::stringstream line(std::move(buf));
+        m_triangles.reserve(m_triangles.size() + data.getTriangleCount());
+        for (size_t t = 0; t < data.getTriangleCount(); ++t) {
+            ObjData::Corner const *c = &data.m_corners[t * 3];
+            m_triangles.push_back({ { data.m_positions[c[0].m_position], data.m_positions[c[1].m_position], data.m_positions[c[2].m_position] }, 0, 0 });
+        }
+        return true;
+    }
 
-            char lineType;
+    bool TexturedMesh::loadFromFile(std::string const &path, bool hasTexture) {
 
-            line >> lineType;
+        ObjData data;
+        if (!ObjParser::parseFile(path, data)) {
+            return false;
+        }
 
-            switch (lineType) {
-            case 'v': {
-                Vec3D v;
-                line >> v.m_x >> v.m_y >> v.m_z;
-                verts.push_back(v);
-                break;
-            }
-            case 'f': {
-                int f[3];
-                line >> f[0] >> f[1] >> f[2];
-                m_triangles.push_back({ verts[f[0] - 1], verts[f[1] - 1], verts[f[2] - 1] });
-                break;
-            }
-            default: {
-                break;
-            }
+        m_triangles.reserve(m_triangles.size() + data.getTriangleCount());
+        for (size_t t = 0; t < data.getTriangleCount(); ++t) {
+            ObjData::Corner const *c = &data.m_corners[t * 3];
+            TexturedTriangle triangle{};
+            for (int i = 0; i < 3; ++i) {
+                triangle.m_vertices[i] = data.m_positions[c[i].m_position];
+                if (hasTexture) {
+                    triangle.m_textures[i] = getObjTexture(data, c[i].m_texture);
+                }
             }
+            m_triangles.push_back(triangle);
         }
         return true;
     }
 
-    bool TexturedMesh::loadFromFile(std::string const &path, bool hasTexture) {
+    // Key used to find vertices that were already added to indexed mesh
+    struct VertexKey {
+        float m_vals[5];
 
-        std::ifstream f(path);
-        if (!f.is_open()) {
-            return false;
+        bool operator==(VertexKey const &rhs) const {
+            return std::memcmp(m_vals, rhs.m_vals, sizeof(m_vals)) == 0;
         }
+    };
+
+    struct VertexKeyHash {
+        size_t operator()(VertexKey const &key) const {
+            // FNV-1a over bytes of key
+            unsigned char const *bytes = reinterpret_cast<unsigned char const *>(key.m_vals);
+            size_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < sizeof(key.m_vals); ++i) {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+            return hash;
+        }
+    };
+
+    // Adds vertex to mesh if same vertex wasn't added yet, returns its index
+    static uint32_t addUniqueVertex(IndexedMesh &mesh, std::unordered_map<VertexKey, uint32_t, VertexKeyHash> &added, Vec3D const &pos, Vec2D const *tex) {
+        VertexKey key{ { pos.m_x, pos.m_y, pos.m_z, tex ? tex->m_u : 0.0f, tex ? tex->m_v : 0.0f } };
+        auto found = added.find(key);
+        if (found != added.end()) {
+            return found->second;
+        }
+        uint32_t index = static_cast<uint32_t>(added.size());
+        added.emplace(key, index);
+        mesh.m_vertices.resize(index + 1);
+        mesh.m_vertices.set(index, pos);
+        if (tex) {
+            mesh.m_textures.push_back(*tex);
+        }
+        return index;
+    }
+
+    size_t IndexedMesh::getTriangleCount() const {
+        return m_indices.size() / 3;
+    }
 
-        // Buffer in which lines of file are read
-        std::string buf;
+    bool IndexedMesh::hasTexture() const {
+        return !m_textures.empty();
+    }
 
-        // Local cache of vertices
-        std::vector<Vec3D> verts;
-        
-        // Local cache of texture vertices
-        std::vector<Vec2D> texts;
+    bool IndexedMesh::hasNormals() const {
+        return !m_normals.empty();
+    }
 
-        while (std::getline(f, buf)) {
-            if (buf.empty()) {
-                continue;
-            }
+    void IndexedMesh::updateBounds() {
+        m_bounds = AABB::fromStream(m_vertices);
+    }
 
-            // String stream to parse input from buffer
-            std::stringstream line(std::move(buf));
+    void IndexedMesh::updateFaceNormals() {
+        size_t numTriangles = getTriangleCount();
+        m_faceNormals.resize(numTriangles);
+        for (size_t t = 0; t < numTriangles; ++t) {
+            Vec3D p0 = m_vertices.get(m_indices[t * 3]);
+            Vec3D normal = (m_vertices.get(m_indices[t * 3 + 1]) - p0).crossProduct(m_vertices.get(m_indices[t * 3 + 2]) - p0);
+            float length = normal.length();
+            normal = length > 0.0f ? normal / length : Vec3D{ 0.0f, 0.0f, 0.0f };
+            normal.m_w = 0.0f;
+            m_faceNormals[t] = normal;
+        }
+    }
 
-            char lineType;
+    // Corner of face from .obj file used as key when same corners are merged into one vertex
+    struct CornerKeyHash {
+        size_t operator()(ObjData::Corner const &corner) const {
+            uint64_t hash = static_cast<uint32_t>(corner.m_position);
+            hash = hash * 0x9E3779B97F4A7C15ull + static_cast<uint32_t>(corner.m_texture);
+            hash = hash * 0x9E3779B97F4A7C15ull + static_cast<uint32_t>(corner.m_normal);
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+    };
 
-            line >> lineType;
+    struct CornerKeyEqual {
+        bool operator()(ObjData::Corner const &lhs, ObjData::Corner const &rhs) const {
+            return lhs.m_position == rhs.m_position && lhs.m_texture == rhs.m_texture && lhs.m_normal == rhs.m_normal;
+        }
+    };
 
-            switch (lineType) {
-            case 'v': {
-                char next;
-                line.read(&next, 1);
-                if (next == 't') {
-                    Vec2D v;
-                    line >> v.m_u >> v.m_v;
-                    //v.m_u = 1.0f - v.m_u;
-                    v.m_v = 1.0f - v.m_v;
-                    texts.push_back(v);
-                }
-                else {
-                    Vec3D v;
-                    line >> v.m_x >> v.m_y >> v.m_z;
-                    verts.push_back(v);
-                }
-                break;
+    bool IndexedMesh::loadFromFile(std::string const &path, bool hasTexture) {
+
+        ObjData data;
+        if (!ObjParser::parseFile(path, data)) {
+            return false;
+        }
+
+        IndexedMesh res;
+        res.m_indices.reserve(data.m_corners.size());
+        bool hasNormals = !data.m_normals.empty();
+        if (!hasTexture && !hasNormals) {
+            // Vertices of file are already shared by faces
+            res.m_vertices.resize(data.m_positions.size());
+            for (size_t i = 0; i < data.m_positions.size(); ++i) {
+                res.m_vertices.set(i, data.m_positions[i]);
+            }
+            for (auto const &corner : data.m_corners) {
+                res.m_indices.push_back(static_cast<uint32_t>(corner.m_position));
             }
-            case 'f': {
+        }
+        else {
+            // Every unique combination of position, texture vertex and normal becomes vertex of mesh
+            std::unordered_map<ObjData::Corner, uint32_t, CornerKeyHash, CornerKeyEqual> added;
+            for (auto corner : data.m_corners) {
                 if (!hasTexture) {
-                    int f[3];
-                    line >> f[0] >> f[1] >> f[2];
-                    m_triangles.push_back({ verts[f[0] - 1], verts[f[1] - 1], verts[f[2] - 1] });
-                    break;
+                    corner.m_texture = -1;
                 }
-                else {
-                    std::string tokens[6];
-                    int tokensCount = -1;
-                    char c;
-                    while (line.read(&c, 1)) {
-                        if (c == ' ' || c == '/') {
-                            ++tokensCount;
-                        }
-                        else {
-                            tokens[tokensCount].append(1, c);
-                        }
+                auto found = added.find(corner);
+                if (found == added.end()) {
+                    uint32_t index = static_cast<uint32_t>(added.size());
+                    found = added.emplace(corner, index).first;
+                    res.m_vertices.resize(index + 1);
+                    res.m_vertices.set(index, data.m_positions[corner.m_position]);
+                    if (hasTexture) {
+                        res.m_textures.push_back(getObjTexture(data, corner.m_texture));
+                    }
+                    if (hasNormals) {
+                        res.m_normals.push_back(corner.m_normal >= 0 ? data.m_normals[corner.m_normal] : Vec3D{ 0.0f, 0.0f, 0.0f, 0.0f });
                     }
-
-                    m_triangles.push_back({ verts[std::stoi(tokens[0]) - 1], verts[std::stoi(tokens[2]) - 1], verts[std::stoi(tokens[4]) - 1],
-                                            texts[std::stoi(tokens[1]) - 1], texts[std::stoi(tokens[3]) - 1], texts[std::stoi(tokens[5]) - 1] });
-                    break;
                 }
+                res.m_indices.push_back(found->second);
             }
-            default: {
-                break;
+        }
+        res.updateBounds();
+        res.updateFaceNormals();
+        *this = std::move(res);
+        return true;
+    }
+
+    IndexedMesh IndexedMesh::fromMesh(Mesh const &mesh) {
+        IndexedMesh res;
+        std::unordered_map<VertexKey, uint32_t, VertexKeyHash> added;
+        res.m_indices.reserve(mesh.m_triangles.size() * 3);
+        for (auto const &triangle : mesh.m_triangles) {
+            for (int i = 0; i < 3; ++i) {
+                res.m_indices.push_back(addUniqueVertex(res, added, triangle.m_vertices[i], nullptr));
             }
+        }
+        res.updateBounds();
+        res.updateFaceNormals();
+        return res;
+    }
+
+    IndexedMesh IndexedMesh::fromMesh(TexturedMesh const &mesh, bool hasTexture) {
+        IndexedMesh res;
+        std::unordered_map<VertexKey, uint32_t, VertexKeyHash> added;
+        res.m_indices.reserve(mesh.m_triangles.size() * 3);
+        for (auto const &triangle : mesh.m_triangles) {
+            for (int i = 0; i < 3; ++i) {
+                res.m_indices.push_back(addUniqueVertex(res, added, triangle.m_vertices[i], hasTexture ? &triangle.m_textures[i] : nullptr));
             }
         }
-        return true;
+        res.updateBounds();
+        res.updateFaceNormals();
+        return res;
     }
 
 } // GE
\ No newline at end of file
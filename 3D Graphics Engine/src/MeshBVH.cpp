@@ -0,0 +1,153 @@
+#include "MeshBVH.hpp"
+#include "MeshOptimizer.hpp"
+#include <algorithm>
+
+namespace GE {
+
+    struct BVHBuildState {
+        IndexedMesh const &m_mesh;
+        std::vector<MeshBVH::Node> &m_nodes;
+        std::vector<uint32_t> m_order;
+        std::vector<Vec3D> m_centroids;
+        size_t m_leafSize;
+    };
+
+    static void buildNode(BVHBuildState &state, uint32_t nodeIndex, uint32_t first, uint32_t count) {
+        AABB bounds, centroidBounds;
+        for (uint32_t i = first; i < first + count; ++i) {
+            uint32_t t = state.m_order[i];
+            for (int v = 0; v < 3; ++v) {
+                bounds.extend(state.m_mesh.m_vertices.get(state.m_mesh.m_indices[t * 3 + v]));
+            }
+            centroidBounds.extend(state.m_centroids[t]);
+        }
+
+        MeshBVH::Node &node = state.m_nodes[nodeIndex];
+        node.m_bounds = bounds;
+        node.m_range = MeshBVH::Range{ first, count, 0, 0 };
+        node.m_firstChild = 0;
+        if (count <= state.m_leafSize) {
+            return;
+        }
+
+        // Split in the middle along axis where triangle centers are spread most
+        Vec3D extents = centroidBounds.getExtents();
+        int axis = extents.m_x > extents.m_y ? (extents.m_x > extents.m_z ? 0 : 2) : (extents.m_y > extents.m_z ? 1 : 2);
+        if ((&extents.m_x)[axis] <= 0.0f) {
+            return;
+        }
+        auto &centroids = state.m_centroids;
+        uint32_t half = count / 2;
+        std::nth_element(state.m_order.begin() + first, state.m_order.begin() + first + half, state.m_order.begin() + first + count,
+            [&centroids, axis](uint32_t a, uint32_t b) {
+                return (&centroids[a].m_x)[axis] < (&centroids[b].m_x)[axis];
+            }
+        );
+
+        // Node reference is invalid after resize
+        uint32_t firstChild = static_cast<uint32_t>(state.m_nodes.size());
+        state.m_nodes.resize(state.m_nodes.size() + 2);
+        state.m_nodes[nodeIndex].m_firstChild = firstChild;
+        buildNode(state, firstChild, first, half);
+        buildNode(state, firstChild + 1, first + half, count - half);
+    }
+
+    MeshBVH MeshBVH::build(IndexedMesh &mesh, size_t leafSize) {
+        MeshBVH bvh;
+        size_t numTriangles = mesh.getTriangleCount();
+        if (numTriangles == 0) {
+            return bvh;
+        }
+
+        BVHBuildState state{ mesh, bvh.m_nodes, {}, {}, leafSize > 0 ? leafSize : 1 };
+        state.m_order.resize(numTriangles);
+        state.m_centroids.resize(numTriangles);
+        for (size_t t = 0; t < numTriangles; ++t) {
+            state.m_order[t] = static_cast<uint32_t>(t);
+            state.m_centroids[t] = (mesh.m_vertices.get(mesh.m_indices[t * 3]) + mesh.m_vertices.get(mesh.m_indices[t * 3 + 1]) + mesh.m_vertices.get(mesh.m_indices[t * 3 + 2])) / 3.0f;
+        }
+        bvh.m_nodes.resize(1);
+        buildNode(state, 0, 0, static_cast<uint32_t>(numTriangles));
+
+        // Triangles are stored in order of leaves, vertices in order of first use
+        std::vector<uint32_t> indices(mesh.m_indices.size());
+        for (size_t t = 0; t < numTriangles; ++t) {
+            std::copy_n(&mesh.m_indices[state.m_order[t] * 3], 3, &indices[t * 3]);
+        }
+        mesh.m_indices = std::move(indices);
+        if (mesh.m_faceNormals.size() == numTriangles) {
+            std::vector<Vec3D> faceNormals(numTriangles);
+            for (size_t t = 0; t < numTriangles; ++t) {
+                faceNormals[t] = mesh.m_faceNormals[state.m_order[t]];
+            }
+            mesh.m_faceNormals = std::move(faceNormals);
+        }
+        else {
+            mesh.updateFaceNormals();
+        }
+        MeshOptimizer::optimizeVertexFetch(mesh);
+
+        // Children always follow their parent so going backwards visits children first
+        for (size_t n = bvh.m_nodes.size(); n-- > 0;) {
+            Node &node = bvh.m_nodes[n];
+            uint32_t minVertex, maxVertex;
+            if (node.m_firstChild == 0) {
+                minVertex = UINT32_MAX;
+                maxVertex = 0;
+                for (size_t i = node.m_range.m_firstTriangle * 3; i < (node.m_range.m_firstTriangle + node.m_range.m_triangleCount) * 3; ++i) {
+                    minVertex = mesh.m_indices[i] < minVertex ? mesh.m_indices[i] : minVertex;
+                    maxVertex = mesh.m_indices[i] > maxVertex ? mesh.m_indices[i] : maxVertex;
+                }
+            }
+            else {
+                Range const &left = bvh.m_nodes[node.m_firstChild].m_range;
+                Range const &right = bvh.m_nodes[node.m_firstChild + 1].m_range;
+                minVertex = left.m_firstVertex < right.m_firstVertex ? left.m_firstVertex : right.m_firstVertex;
+                uint32_t leftEnd = left.m_firstVertex + left.m_vertexCount - 1;
+                uint32_t rightEnd = right.m_firstVertex + right.m_vertexCount - 1;
+                maxVertex = leftEnd > rightEnd ? leftEnd : rightEnd;
+            }
+            node.m_range.m_firstVertex = minVertex;
+            node.m_range.m_vertexCount = maxVertex - minVertex + 1;
+        }
+        return bvh;
+    }
+
+    void MeshBVH::cull(Frustum const &frustum, std::vector<Range> &visible) const {
+        if (!m_nodes.empty()) {
+            cullNode(0, frustum, visible);
+        }
+    }
+
+    std::vector<MeshBVH::Node> const &MeshBVH::getNodes() const {
+        return m_nodes;
+    }
+
+    void MeshBVH::cullNode(uint32_t nodeIndex, Frustum const &frustum, std::vector<Range> &visible) const {
+        Node const &node = m_nodes[nodeIndex];
+        Frustum::Containment containment = frustum.test(node.m_bounds);
+        if (containment == Frustum::Containment::Outside) {
+            return;
+        }
+        if (containment == Frustum::Containment::Intersects && node.m_firstChild != 0) {
+            cullNode(node.m_firstChild, frustum, visible);
+            cullNode(node.m_firstChild + 1, frustum, visible);
+            return;
+        }
+
+        // Whole node is visible or it is a leaf
+        Range const &range = node.m_range;
+        if (!visible.empty() && visible.back().m_firstTriangle + visible.back().m_triangleCount == range.m_firstTriangle) {
+            Range &last = visible.back();
+            uint32_t lastEnd = last.m_firstVertex + last.m_vertexCount;
+            uint32_t rangeEnd = range.m_firstVertex + range.m_vertexCount;
+            last.m_triangleCount += range.m_triangleCount;
+            last.m_firstVertex = last.m_firstVertex < range.m_firstVertex ? last.m_firstVertex : range.m_firstVertex;
+            last.m_vertexCount = (lastEnd > rangeEnd ? lastEnd : rangeEnd) - last.m_firstVertex;
+        }
+        else {
+            visible.push_back(range);
+        }
+    }
+
+} // GE
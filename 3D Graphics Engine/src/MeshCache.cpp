@@ -0,0 +1,290 @@
+#include "MeshCache.hpp"
+#include "MappedFile.hpp"
+#include "MeshOptimizer.hpp"
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <type_traits>
+
+namespace GE {
+
+    // Layout of cache file: header, x[], y[], z[], indices[], Vec2D[] if textured, Vec3D[] normals if present, Vec3D[] normals of triangles
+    // Texture vertices and normals are stored exactly as IndexedMesh keeps them, so every array is one copy
+    struct MeshCacheHeader {
+        char m_magic[4];
+        uint32_t m_version;
+        uint32_t m_flags;
+        uint32_t m_vertexCount;
+        uint32_t m_indexCount;
+        // Number of levels in LOD chain this cache belongs to, 0 for cache of plain mesh
+        uint32_t m_levelCount;
+        uint64_t m_sourceSize;
+        int64_t m_sourceTime;
+        uint64_t m_sourceHash;
+        float m_bounds[6];
+    };
+
+    static constexpr char meshCacheMagic[4] = { 'G', 'E', 'M', 'C' };
+    static constexpr uint32_t meshCacheVersion = 4;
+
+    static_assert(std::is_trivially_copyable<Vec2D>::value && std::is_trivially_copyable<Vec3D>::value, "Cache copies vectors as bytes");
+
+    static constexpr uint32_t flagTexture = 1;
+    static constexpr uint32_t flagNormals = 2;
+
+    // What identifies .obj file that cache was built from
+    // Size and time are read without opening file, hash is computed only when it is needed
+    struct SourceInfo {
+        uint64_t m_size;
+        int64_t m_time;
+        uint64_t m_hash;
+        bool m_hashed;
+    };
+
+    static bool getSourceInfo(std::string const &objPath, SourceInfo &info) {
+        std::error_code error;
+        auto time = std::filesystem::last_write_time(objPath, error);
+        if (error) {
+            return false;
+        }
+        auto size = std::filesystem::file_size(objPath, error);
+        if (error) {
+            return false;
+        }
+        info.m_size = static_cast<uint64_t>(size);
+        info.m_time = static_cast<int64_t>(time.time_since_epoch().count());
+        info.m_hash = 0;
+        info.m_hashed = false;
+        return true;
+    }
+
+    static bool hashSource(std::string const &objPath, SourceInfo &info) {
+        if (info.m_hashed) {
+            return true;
+        }
+        MappedFile file;
+        if (!file.open(objPath)) {
+            return false;
+        }
+        info.m_hash = MeshCache::hashBytes(file.data(), file.size());
+        info.m_hashed = true;
+        return true;
+    }
+
+    static size_t getPayloadSize(MeshCacheHeader const &header) {
+        size_t size = sizeof(float) * 3 * header.m_vertexCount + sizeof(uint32_t) * header.m_indexCount + sizeof(Vec3D) * (header.m_indexCount / 3);
+        if (header.m_flags & flagTexture) {
+            size += sizeof(Vec2D) * header.m_vertexCount;
+        }
+        if (header.m_flags & flagNormals) {
+            size += sizeof(Vec3D) * header.m_vertexCount;
+        }
+        return size;
+    }
+
+    static bool readCache(std::string const &cachePath, std::string const &objPath, SourceInfo &source, bool hasTexture, IndexedMesh &mesh, uint32_t &levelCount) {
+        MappedFile file;
+        if (!file.open(cachePath) || file.size() < sizeof(MeshCacheHeader)) {
+            return false;
+        }
+
+        MeshCacheHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.m_magic, meshCacheMagic, sizeof(meshCacheMagic)) != 0 || header.m_version != meshCacheVersion ||
+            header.m_sourceSize != source.m_size ||
+            ((header.m_flags & flagTexture) != 0) != hasTexture || header.m_indexCount % 3 != 0 ||
+            file.size() != sizeof(header) + getPayloadSize(header)) {
+            return false;
+        }
+
+        // Same size but different time(file was copied or touched) - only then .obj is read to compare its hash
+        if (header.m_sourceTime != source.m_time && (!hashSource(objPath, source) || header.m_sourceHash != source.m_hash)) {
+            return false;
+        }
+
+        // Arrays are copied straight from mapped file
+        char const *cur = file.data() + sizeof(header);
+        auto readArray = [&cur](void *dst, size_t bytes) {
+            if (bytes) {
+                std::memcpy(dst, cur, bytes);
+            }
+            cur += bytes;
+        };
+
+        IndexedMesh res;
+        size_t numVertices = header.m_vertexCount;
+        res.m_vertices.resize(numVertices);
+        readArray(res.m_vertices.m_x.data(), sizeof(float) * numVertices);
+        readArray(res.m_vertices.m_y.data(), sizeof(float) * numVertices);
+        readArray(res.m_vertices.m_z.data(), sizeof(float) * numVertices);
+
+        res.m_indices.resize(header.m_indexCount);
+        readArray(res.m_indices.data(), sizeof(uint32_t) * header.m_indexCount);
+        for (uint32_t index : res.m_indices) {
+            if (index >= numVertices) {
+                return false;
+            }
+        }
+
+        if (header.m_flags & flagTexture) {
+            res.m_textures.resize(numVertices);
+            readArray(res.m_textures.data(), sizeof(Vec2D) * numVertices);
+        }
+        if (header.m_flags & flagNormals) {
+            res.m_normals.resize(numVertices);
+            readArray(res.m_normals.data(), sizeof(Vec3D) * numVertices);
+        }
+        res.m_faceNormals.resize(header.m_indexCount / 3);
+        readArray(res.m_faceNormals.data(), sizeof(Vec3D) * res.m_faceNormals.size());
+
+        res.m_bounds.m_min = Vec3D{ header.m_bounds[0], header.m_bounds[1], header.m_bounds[2] };
+        res.m_bounds.m_max = Vec3D{ header.m_bounds[3], header.m_bounds[4], header.m_bounds[5] };
+        mesh = std::move(res);
+        levelCount = header.m_levelCount;
+        return true;
+    }
+
+    static bool writeCache(std::string const &cachePath, SourceInfo const &source, IndexedMesh const &mesh, uint32_t levelCount) {
+        if (mesh.m_faceNormals.size() != mesh.getTriangleCount()) {
+            return false;
+        }
+
+        MeshCacheHeader header{};
+        std::memcpy(header.m_magic, meshCacheMagic, sizeof(meshCacheMagic));
+        header.m_version = meshCacheVersion;
+        header.m_flags = (mesh.hasTexture() ? flagTexture : 0) | (mesh.hasNormals() ? flagNormals : 0);
+        header.m_vertexCount = static_cast<uint32_t>(mesh.m_vertices.size());
+        header.m_indexCount = static_cast<uint32_t>(mesh.m_indices.size());
+        header.m_levelCount = levelCount;
+        header.m_sourceSize = source.m_size;
+        header.m_sourceTime = source.m_time;
+        header.m_sourceHash = source.m_hash;
+        header.m_bounds[0] = mesh.m_bounds.m_min.m_x;
+        header.m_bounds[1] = mesh.m_bounds.m_min.m_y;
+        header.m_bounds[2] = mesh.m_bounds.m_min.m_z;
+        header.m_bounds[3] = mesh.m_bounds.m_max.m_x;
+        header.m_bounds[4] = mesh.m_bounds.m_max.m_y;
+        header.m_bounds[5] = mesh.m_bounds.m_max.m_z;
+
+        std::vector<char> buf(sizeof(header) + getPayloadSize(header));
+        char *cur = buf.data();
+        auto writeArray = [&cur](void const *src, size_t bytes) {
+            if (bytes) {
+                std::memcpy(cur, src, bytes);
+            }
+            cur += bytes;
+        };
+
+        size_t numVertices = header.m_vertexCount;
+        writeArray(&header, sizeof(header));
+        writeArray(mesh.m_vertices.m_x.data(), sizeof(float) * numVertices);
+        writeArray(mesh.m_vertices.m_y.data(), sizeof(float) * numVertices);
+        writeArray(mesh.m_vertices.m_z.data(), sizeof(float) * numVertices);
+        writeArray(mesh.m_indices.data(), sizeof(uint32_t) * mesh.m_indices.size());
+        writeArray(mesh.m_textures.data(), sizeof(Vec2D) * mesh.m_textures.size());
+        writeArray(mesh.m_normals.data(), sizeof(Vec3D) * mesh.m_normals.size());
+        writeArray(mesh.m_faceNormals.data(), sizeof(Vec3D) * mesh.m_faceNormals.size());
+
+        // Written under temporary name first so other programs never see half written cache
+        std::string tmpPath = cachePath + ".tmp";
+        {
+            std::ofstream f(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!f.is_open() || !f.write(buf.data(), buf.size())) {
+                return false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(tmpPath, cachePath, error);
+        return !error;
+    }
+
+    bool MeshCache::load(std::string const &objPath, IndexedMesh &mesh, bool hasTexture) {
+        std::string cachePath = getCachePath(objPath);
+
+        SourceInfo source;
+        if (!getSourceInfo(objPath, source)) {
+            // No .obj file - nothing to compare cache with
+            return false;
+        }
+        uint32_t levelCount = 0;
+        if (readCache(cachePath, objPath, source, hasTexture, mesh, levelCount)) {
+            // Cache was accepted by hash - new time is saved so next load doesn't read .obj again
+            if (source.m_hashed) {
+                writeCache(cachePath, source, mesh, 0);
+            }
+            return true;
+        }
+        if (!mesh.loadFromFile(objPath, hasTexture) || !hashSource(objPath, source)) {
+            return false;
+        }
+        // Optimization is done once when cache is built
+        MeshOptimizer::optimize(mesh);
+        // Failing to write cache(read only folder) doesn't stop loading
+        writeCache(cachePath, source, mesh, 0);
+        return true;
+    }
+
+    bool MeshCache::loadLOD(std::string const &objPath, MeshLOD &lod, bool hasTexture) {
+        IndexedMesh base;
+        if (!load(objPath, base, hasTexture)) {
+            return false;
+        }
+        SourceInfo source;
+        if (!getSourceInfo(objPath, source)) {
+            return false;
+        }
+
+        // Every simplified level is in its own file that also says how many levels chain has
+        std::vector<IndexedMesh> levels;
+        levels.push_back(std::move(base));
+        uint32_t levelCount = 0;
+        IndexedMesh level;
+        if (readCache(getLevelCachePath(objPath, 1), objPath, source, hasTexture, level, levelCount) && levelCount >= 2) {
+            levels.push_back(std::move(level));
+            for (uint32_t i = 2; i < levelCount; ++i) {
+                uint32_t count = 0;
+                if (!readCache(getLevelCachePath(objPath, i), objPath, source, hasTexture, level, count) || count != levelCount) {
+                    break;
+                }
+                levels.push_back(std::move(level));
+            }
+            if (levels.size() == levelCount) {
+                if (source.m_hashed) {
+                    for (uint32_t i = 1; i < levelCount; ++i) {
+                        writeCache(getLevelCachePath(objPath, i), source, levels[i], levelCount);
+                    }
+                }
+                lod = MeshLOD::fromLevels(std::move(levels));
+                return true;
+            }
+            levels.resize(1);
+        }
+
+        // Simplification is done once when level caches are built
+        lod = MeshLOD::build(levels[0]);
+        if (hashSource(objPath, source)) {
+            levelCount = static_cast<uint32_t>(lod.getLevelCount());
+            for (uint32_t i = 1; i < levelCount; ++i) {
+                writeCache(getLevelCachePath(objPath, i), source, lod.getLevel(i), levelCount);
+            }
+        }
+        return true;
+    }
+
+    std::string MeshCache::getCachePath(std::string const &objPath) {
+        return objPath + ".gemesh";
+    }
+
+    std::string MeshCache::getLevelCachePath(std::string const &objPath, size_t level) {
+        return objPath + ".lod" + std::to_string(level) + ".gemesh";
+    }
+
+    uint64_t MeshCache::hashBytes(char const *data, size_t size) {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+} // GE
@@ -0,0 +1,124 @@
+#include "MeshInstances.hpp"
+#include <cmath>
+
+namespace GE {
+
+    MeshInstances::MeshInstances(IndexedMesh const &mesh, MeshBVH const *bvh)
+        : m_mesh(&mesh)
+        , m_bvh(bvh) {
+    }
+
+    IndexedMesh const &MeshInstances::getMesh() const {
+        return *m_mesh;
+    }
+
+    MeshBVH const *MeshInstances::getBVH() const {
+        return m_bvh;
+    }
+
+    uint32_t MeshInstances::add(Matrix4x4 const &model) {
+        uint32_t index = static_cast<uint32_t>(m_models.size());
+        m_models.emplace_back();
+        m_modelInverses.emplace_back();
+        m_minX.push_back(0.0f);
+        m_minY.push_back(0.0f);
+        m_minZ.push_back(0.0f);
+        m_maxX.push_back(0.0f);
+        m_maxY.push_back(0.0f);
+        m_maxZ.push_back(0.0f);
+        setModel(index, model);
+        return index;
+    }
+
+    void MeshInstances::setModel(uint32_t index, Matrix4x4 const &model) {
+        m_models[index] = model;
+        m_modelInverses[index] = model.getInverse();
+
+        // Box around transformed box - center is transformed, extents are summed from absolute values of matrix
+        AABB const &bounds = m_mesh->m_bounds;
+        if (bounds.isEmpty()) {
+            m_minX[index] = m_minY[index] = m_minZ[index] = 0.0f;
+            m_maxX[index] = m_maxY[index] = m_maxZ[index] = -1.0f;
+            return;
+        }
+        Vec3D center = model.multiplyVector(bounds.getCenter());
+        Vec3D extents = bounds.getExtents();
+        float world[3];
+        for (int c = 0; c < 3; ++c) {
+            world[c] = std::fabs(model[0][c]) * extents.m_x + std::fabs(model[1][c]) * extents.m_y + std::fabs(model[2][c]) * extents.m_z;
+        }
+        m_minX[index] = center.m_x - world[0];
+        m_minY[index] = center.m_y - world[1];
+        m_minZ[index] = center.m_z - world[2];
+        m_maxX[index] = center.m_x + world[0];
+        m_maxY[index] = center.m_y + world[1];
+        m_maxZ[index] = center.m_z + world[2];
+    }
+
+    Matrix4x4 const &MeshInstances::getModel(uint32_t index) const {
+        return m_models[index];
+    }
+
+    Matrix4x4 const &MeshInstances::getModelInverse(uint32_t index) const {
+        return m_modelInverses[index];
+    }
+
+    AABB MeshInstances::getBounds(uint32_t index) const {
+        AABB box;
+        box.m_min = Vec3D{ m_minX[index], m_minY[index], m_minZ[index] };
+        box.m_max = Vec3D{ m_maxX[index], m_maxY[index], m_maxZ[index] };
+        return box;
+    }
+
+    size_t MeshInstances::size() const {
+        return m_models.size();
+    }
+
+    void MeshInstances::reserve(size_t count) {
+        m_models.reserve(count);
+        m_modelInverses.reserve(count);
+        m_minX.reserve(count);
+        m_minY.reserve(count);
+        m_minZ.reserve(count);
+        m_maxX.reserve(count);
+        m_maxY.reserve(count);
+        m_maxZ.reserve(count);
+    }
+
+    void MeshInstances::clear() {
+        m_models.clear();
+        m_modelInverses.clear();
+        m_minX.clear();
+        m_minY.clear();
+        m_minZ.clear();
+        m_maxX.clear();
+        m_maxY.clear();
+        m_maxZ.clear();
+    }
+
+    void MeshInstances::cull(Frustum const &frustum, std::vector<Visible> &visible) const {
+        size_t count = m_models.size();
+        for (size_t i = 0; i < count; ++i) {
+            if (m_minX[i] > m_maxX[i]) {
+                continue;
+            }
+            bool inside = true;
+            bool outside = false;
+            for (Plane const &plane : frustum.m_planes) {
+                // Same test as Frustum::test - corners farthest in front of plane and farthest behind it
+                float nx = plane.m_normal.m_x, ny = plane.m_normal.m_y, nz = plane.m_normal.m_z;
+                float front = nx * (nx >= 0.0f ? m_maxX[i] : m_minX[i]) + ny * (ny >= 0.0f ? m_maxY[i] : m_minY[i]) + nz * (nz >= 0.0f ? m_maxZ[i] : m_minZ[i]) + plane.m_d;
+                float back = nx * (nx >= 0.0f ? m_minX[i] : m_maxX[i]) + ny * (ny >= 0.0f ? m_minY[i] : m_maxY[i]) + nz * (nz >= 0.0f ? m_minZ[i] : m_maxZ[i]) + plane.m_d;
+                if (front < 0.0f) {
+                    outside = true;
+                    break;
+                }
+                inside = inside && back >= 0.0f;
+            }
+            if (!outside) {
+                visible.push_back(Visible{ static_cast<uint32_t>(i), inside });
+            }
+        }
+    }
+
+} // GE
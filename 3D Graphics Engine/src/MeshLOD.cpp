@@ -0,0 +1,75 @@
+#include "MeshLOD.hpp"
+#include <cmath>
+
+namespace GE {
+
+    MeshLOD MeshLOD::build(IndexedMesh const &mesh, size_t maxLevels, float ratio, size_t minTriangles) {
+        MeshLOD lod;
+        lod.m_levels.push_back(mesh);
+        while (lod.m_levels.size() < maxLevels) {
+            IndexedMesh const &last = lod.m_levels.back();
+            size_t target = static_cast<size_t>(static_cast<float>(last.getTriangleCount()) * ratio);
+            if (target < minTriangles) {
+                break;
+            }
+            IndexedMesh next = MeshSimplifier::simplify(last, target);
+            // Level that is barely smaller is not worth memory
+            if (next.getTriangleCount() * 10 > last.getTriangleCount() * 9) {
+                break;
+            }
+            lod.m_levels.push_back(std::move(next));
+        }
+        return lod;
+    }
+
+    MeshLOD MeshLOD::fromLevels(std::vector<IndexedMesh> levels) {
+        MeshLOD lod;
+        lod.m_levels = std::move(levels);
+        return lod;
+    }
+
+    size_t MeshLOD::getLevelCount() const {
+        return m_levels.size();
+    }
+
+    IndexedMesh &MeshLOD::getLevel(size_t level) {
+        return m_levels[level];
+    }
+
+    IndexedMesh const &MeshLOD::getLevel(size_t level) const {
+        return m_levels[level];
+    }
+
+    size_t MeshLOD::selectLevel(Camera const &camera, float screenHeight, Matrix4x4 const &model, float trianglesPerCell) const {
+        AABB const &bounds = m_levels[0].m_bounds;
+        if (bounds.isEmpty()) {
+            return 0;
+        }
+
+        // Biggest scale of model matrix makes sure sphere still contains mesh
+        float scale = 0.0f;
+        for (int r = 0; r < 3; ++r) {
+            float rowLength = Vec3D{ model[r][0], model[r][1], model[r][2] }.length();
+            scale = rowLength > scale ? rowLength : scale;
+        }
+        Vec3D center = model.multiplyVector(bounds.getCenter());
+        float radius = bounds.getExtents().length() * scale;
+        float distance = (center - camera.getPosition()).length();
+        if (distance <= radius) {
+            // Camera is inside of object
+            return 0;
+        }
+
+        // Projected radius in cells, projection[1][1] is 1 / tan(fov / 2)
+        float projectedRadius = radius / std::sqrt(distance * distance - radius * radius) * camera.getProjection()[1][1] * screenHeight * 0.5f;
+        float budget = pi * projectedRadius * projectedRadius * trianglesPerCell;
+
+        for (size_t level = 0; level < m_levels.size(); ++level) {
+            if (static_cast<float>(m_levels[level].getTriangleCount()) <= budget) {
+                return level;
+            }
+        }
+        return m_levels.size() - 1;
+    }
+
+} // GE
@@ -0,0 +1,269 @@
+#include "MeshOptimizer.hpp"
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace GE {
+
+    MeshOptimizerStats MeshOptimizer::optimize(IndexedMesh &mesh) {
+        MeshOptimizerStats stats;
+        stats.m_acmrBefore = getACMR(mesh.m_indices, mesh.m_vertices.size());
+        weldVertices(mesh);
+        optimizeVertexCache(mesh);
+        optimizeVertexFetch(mesh);
+        stats.m_acmrAfter = getACMR(mesh.m_indices, mesh.m_vertices.size());
+        return stats;
+    }
+
+    // All attributes of one vertex, positions can be rounded to grid of epsilon
+    struct WeldKey {
+        float m_vals[8];
+
+        bool operator==(WeldKey const &rhs) const {
+            return std::memcmp(m_vals, rhs.m_vals, sizeof(m_vals)) == 0;
+        }
+    };
+
+    struct WeldKeyHash {
+        size_t operator()(WeldKey const &key) const {
+            unsigned char const *bytes = reinterpret_cast<unsigned char const *>(key.m_vals);
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < sizeof(key.m_vals); ++i) {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    void MeshOptimizer::weldVertices(IndexedMesh &mesh, float epsilon) {
+        size_t numVertices = mesh.m_vertices.size();
+        std::unordered_map<WeldKey, uint32_t, WeldKeyHash> added;
+        std::vector<uint32_t> remap(numVertices);
+
+        auto snap = [epsilon](float val) {
+            // +0.0f turns -0.0f into 0.0f so they are welded too
+            return (epsilon > 0.0f ? std::round(val / epsilon) * epsilon : val) + 0.0f;
+        };
+
+        for (size_t i = 0; i < numVertices; ++i) {
+            WeldKey key{};
+            key.m_vals[0] = snap(mesh.m_vertices.m_x[i]);
+            key.m_vals[1] = snap(mesh.m_vertices.m_y[i]);
+            key.m_vals[2] = snap(mesh.m_vertices.m_z[i]);
+            if (mesh.hasTexture()) {
+                key.m_vals[3] = mesh.m_textures[i].m_u + 0.0f;
+                key.m_vals[4] = mesh.m_textures[i].m_v + 0.0f;
+            }
+            if (mesh.hasNormals()) {
+                key.m_vals[5] = mesh.m_normals[i].m_x + 0.0f;
+                key.m_vals[6] = mesh.m_normals[i].m_y + 0.0f;
+                key.m_vals[7] = mesh.m_normals[i].m_z + 0.0f;
+            }
+            // First vertex with this key stays, others point to it
+            remap[i] = added.emplace(key, static_cast<uint32_t>(i)).first->second;
+        }
+
+        for (auto &index : mesh.m_indices) {
+            index = remap[index];
+        }
+
+        // Vertices that are not used anymore are removed
+        optimizeVertexFetch(mesh);
+        mesh.updateFaceNormals();
+    }
+
+    // Scoring from "Linear-Speed Vertex Cache Optimisation" by Tom Forsyth
+    static constexpr int forsythCacheSize = 32;
+
+    static float getVertexScore(int cachePosition, uint32_t remainingTriangles) {
+        if (remainingTriangles == 0) {
+            return -1.0f;
+        }
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // Vertices of last triangle get fixed score so it isn't favoured too much
+                score = 0.75f;
+            }
+            else {
+                float scaler = 1.0f / (forsythCacheSize - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scaler, 1.5f);
+            }
+        }
+        // Vertices with few triangles left get boost so they are finished quickly
+        score += 2.0f / std::sqrt(static_cast<float>(remainingTriangles));
+        return score;
+    }
+
+    void MeshOptimizer::optimizeVertexCache(IndexedMesh &mesh) {
+        size_t numVertices = mesh.m_vertices.size();
+        size_t numTriangles = mesh.getTriangleCount();
+        std::vector<uint32_t> const &indices = mesh.m_indices;
+
+        // Triangles that use each vertex
+        std::vector<uint32_t> adjacencyStart(numVertices + 1, 0);
+        for (uint32_t index : indices) {
+            ++adjacencyStart[index + 1];
+        }
+        for (size_t v = 0; v < numVertices; ++v) {
+            adjacencyStart[v + 1] += adjacencyStart[v];
+        }
+        std::vector<uint32_t> adjacency(indices.size());
+        std::vector<uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        std::vector<uint32_t> remaining(numVertices);
+        std::vector<int> cachePosition(numVertices, -1);
+        std::vector<float> vertexScore(numVertices);
+        for (size_t v = 0; v < numVertices; ++v) {
+            remaining[v] = adjacencyStart[v + 1] - adjacencyStart[v];
+            vertexScore[v] = getVertexScore(-1, remaining[v]);
+        }
+
+        std::vector<float> triangleScore(numTriangles);
+        std::vector<bool> emitted(numTriangles, false);
+        for (size_t t = 0; t < numTriangles; ++t) {
+            triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+        }
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+
+        // Cache has 3 extra slots for vertices pushed out by newly added triangle
+        uint32_t cache[forsythCacheSize + 3];
+        int cacheSize = 0;
+
+        size_t scanPosition = 0;
+        int64_t best = -1;
+        for (size_t emittedCount = 0; emittedCount < numTriangles; ++emittedCount) {
+            if (best < 0) {
+                // No candidates in cache - take best of not emitted triangles in order
+                float bestScore = -1.0f;
+                for (; scanPosition < numTriangles && emitted[scanPosition]; ++scanPosition) {
+                }
+                for (size_t t = scanPosition; t < numTriangles; ++t) {
+                    if (!emitted[t] && triangleScore[t] > bestScore) {
+                        bestScore = triangleScore[t];
+                        best = static_cast<int64_t>(t);
+                    }
+                }
+            }
+
+            uint32_t const *tri = &indices[best * 3];
+            emitted[best] = true;
+            result.insert(result.end(), tri, tri + 3);
+
+            // Vertices of emitted triangle go to front of cache
+            uint32_t newCache[forsythCacheSize + 3];
+            int newCacheSize = 0;
+            for (int i = 0; i < 3; ++i) {
+                newCache[newCacheSize++] = tri[i];
+                --remaining[tri[i]];
+
+                // Remove emitted triangle from vertex adjacency
+                uint32_t *begin = &adjacency[adjacencyStart[tri[i]]];
+                uint32_t *end = begin + remaining[tri[i]] + 1;
+                for (uint32_t *cur = begin; cur < end; ++cur) {
+                    if (*cur == best) {
+                        *cur = *(end - 1);
+                        break;
+                    }
+                }
+            }
+            for (int i = 0; i < cacheSize; ++i) {
+                uint32_t v = cache[i];
+                if (v != tri[0] && v != tri[1] && v != tri[2]) {
+                    newCache[newCacheSize++] = v;
+                }
+            }
+
+            // Update scores of vertices in cache and of their triangles
+            for (int i = 0; i < newCacheSize; ++i) {
+                uint32_t v = newCache[i];
+                cachePosition[v] = i < forsythCacheSize ? i : -1;
+                float newScore = getVertexScore(cachePosition[v], remaining[v]);
+                float diff = newScore - vertexScore[v];
+                vertexScore[v] = newScore;
+                for (uint32_t a = adjacencyStart[v]; a < adjacencyStart[v] + remaining[v]; ++a) {
+                    triangleScore[adjacency[a]] += diff;
+                }
+            }
+            cacheSize = newCacheSize < forsythCacheSize ? newCacheSize : forsythCacheSize;
+            std::memcpy(cache, newCache, sizeof(uint32_t) * cacheSize);
+
+            // Next triangle is best one that uses vertex from cache
+            best = -1;
+            float bestScore = -1.0f;
+            for (int i = 0; i < cacheSize; ++i) {
+                uint32_t v = cache[i];
+                for (uint32_t a = adjacencyStart[v]; a < adjacencyStart[v] + remaining[v]; ++a) {
+                    uint32_t t = adjacency[a];
+                    if (triangleScore[t] > bestScore) {
+                        bestScore = triangleScore[t];
+                        best = t;
+                    }
+                }
+            }
+        }
+
+        mesh.m_indices = std::move(result);
+        mesh.updateFaceNormals();
+    }
+
+    void MeshOptimizer::optimizeVertexFetch(IndexedMesh &mesh) {
+        size_t numVertices = mesh.m_vertices.size();
+        constexpr uint32_t unused = ~0u;
+        std::vector<uint32_t> remap(numVertices, unused);
+        uint32_t nextIndex = 0;
+        for (auto &index : mesh.m_indices) {
+            if (remap[index] == unused) {
+                remap[index] = nextIndex++;
+            }
+            index = remap[index];
+        }
+
+        VertexStream vertices;
+        vertices.resize(nextIndex);
+        std::vector<Vec2D> textures(mesh.hasTexture() ? nextIndex : 0);
+        std::vector<Vec3D> normals(mesh.hasNormals() ? nextIndex : 0);
+        for (size_t v = 0; v < numVertices; ++v) {
+            uint32_t to = remap[v];
+            if (to == unused) {
+                continue;
+            }
+            vertices.m_x[to] = mesh.m_vertices.m_x[v];
+            vertices.m_y[to] = mesh.m_vertices.m_y[v];
+            vertices.m_z[to] = mesh.m_vertices.m_z[v];
+            vertices.m_w[to] = mesh.m_vertices.m_w[v];
+            if (mesh.hasTexture()) {
+                textures[to] = mesh.m_textures[v];
+            }
+            if (mesh.hasNormals()) {
+                normals[to] = mesh.m_normals[v];
+            }
+        }
+        mesh.m_vertices = std::move(vertices);
+        mesh.m_textures = std::move(textures);
+        mesh.m_normals = std::move(normals);
+        mesh.updateBounds();
+    }
+
+    float MeshOptimizer::getACMR(std::vector<uint32_t> const &indices, size_t numVertices, size_t cacheSize) {
+        if (indices.size() < 3) {
+            return 0.0f;
+        }
+        // Time when vertex entered cache, vertex is in FIFO cache while fewer than cacheSize misses happened since
+        std::vector<size_t> enteredAt(numVertices, 0);
+        size_t misses = 0;
+        for (uint32_t index : indices) {
+            if (enteredAt[index] == 0 || misses - enteredAt[index] >= cacheSize) {
+                ++misses;
+                enteredAt[index] = misses;
+            }
+        }
+        return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    }
+
+} // GE
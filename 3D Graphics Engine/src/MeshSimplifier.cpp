@@ -0,0 +1,265 @@
+#include "MeshSimplifier.hpp"
+#include "MeshOptimizer.hpp"
+#include <cmath>
+#include <queue>
+#include <unordered_map>
+
+namespace GE {
+
+    // Symmetric 4x4 matrix that gives sum of squared distances to set of planes
+    struct Quadric {
+        double m_a2 = 0, m_ab = 0, m_ac = 0, m_ad = 0;
+        double m_b2 = 0, m_bc = 0, m_bd = 0;
+        double m_c2 = 0, m_cd = 0;
+        double m_d2 = 0;
+
+        // Plane ax + by + cz + d = 0 with normalized (a, b, c)
+        static Quadric fromPlane(double a, double b, double c, double d, double weight) {
+            Quadric q;
+            q.m_a2 = a * a * weight; q.m_ab = a * b * weight; q.m_ac = a * c * weight; q.m_ad = a * d * weight;
+            q.m_b2 = b * b * weight; q.m_bc = b * c * weight; q.m_bd = b * d * weight;
+            q.m_c2 = c * c * weight; q.m_cd = c * d * weight;
+            q.m_d2 = d * d * weight;
+            return q;
+        }
+
+        Quadric &operator+=(Quadric const &rhs) {
+            m_a2 += rhs.m_a2; m_ab += rhs.m_ab; m_ac += rhs.m_ac; m_ad += rhs.m_ad;
+            m_b2 += rhs.m_b2; m_bc += rhs.m_bc; m_bd += rhs.m_bd;
+            m_c2 += rhs.m_c2; m_cd += rhs.m_cd;
+            m_d2 += rhs.m_d2;
+            return *this;
+        }
+
+        double getError(double x, double y, double z) const {
+            return m_a2 * x * x + 2 * m_ab * x * y + 2 * m_ac * x * z + 2 * m_ad * x
+                 + m_b2 * y * y + 2 * m_bc * y * z + 2 * m_bd * y
+                 + m_c2 * z * z + 2 * m_cd * z
+                 + m_d2;
+        }
+    };
+
+    // Planes along open borders get big weight so borders don't shrink
+    static constexpr double borderWeight = 1000.0;
+
+    // Edge that can be collapsed, versions show if its vertices changed since it was queued
+    struct EdgeCollapse {
+        float m_error;
+        uint32_t m_from;
+        uint32_t m_to;
+        uint32_t m_fromVersion;
+        uint32_t m_toVersion;
+        Vec3D m_position;
+        bool m_keepFromAttributes;
+
+        bool operator>(EdgeCollapse const &rhs) const {
+            return m_error > rhs.m_error;
+        }
+    };
+
+    struct SimplifierState {
+        IndexedMesh m_mesh;
+        std::vector<Quadric> m_quadrics;
+        std::vector<std::vector<uint32_t>> m_vertexTriangles;
+        std::vector<uint32_t> m_versions;
+        std::vector<bool> m_removedVertices;
+        std::vector<bool> m_removedTriangles;
+        bool m_fixedPositions;
+
+        Vec3D getPosition(uint32_t v) const {
+            return Vec3D{ m_mesh.m_vertices.m_x[v], m_mesh.m_vertices.m_y[v], m_mesh.m_vertices.m_z[v] };
+        }
+    };
+
+    static EdgeCollapse makeCollapse(SimplifierState const &state, uint32_t from, uint32_t to) {
+        Quadric q = state.m_quadrics[from];
+        q += state.m_quadrics[to];
+
+        Vec3D candidates[3] = { state.getPosition(to), state.getPosition(from), (state.getPosition(to) + state.getPosition(from)) * 0.5f };
+        int numCandidates = state.m_fixedPositions ? 2 : 3;
+
+        EdgeCollapse collapse{ FLT_MAX, from, to, state.m_versions[from], state.m_versions[to], candidates[0], false };
+        for (int i = 0; i < numCandidates; ++i) {
+            double error = q.getError(candidates[i].m_x, candidates[i].m_y, candidates[i].m_z);
+            error = error > 0.0 ? error : 0.0;
+            if (error < collapse.m_error) {
+                collapse.m_error = static_cast<float>(error);
+                collapse.m_position = candidates[i];
+                collapse.m_keepFromAttributes = i == 1;
+            }
+        }
+        return collapse;
+    }
+
+    // True if moving vertex to new position turns any of its triangles(except ones that will be removed) upside down
+    static bool flipsTriangles(SimplifierState const &state, uint32_t moved, uint32_t other, Vec3D const &position) {
+        auto const &indices = state.m_mesh.m_indices;
+        for (uint32_t t : state.m_vertexTriangles[moved]) {
+            if (state.m_removedTriangles[t]) {
+                continue;
+            }
+            uint32_t const *tri = &indices[t * 3];
+            if (tri[0] == other || tri[1] == other || tri[2] == other) {
+                continue;
+            }
+            Vec3D before[3], after[3];
+            for (int i = 0; i < 3; ++i) {
+                before[i] = state.getPosition(tri[i]);
+                after[i] = tri[i] == moved ? position : before[i];
+            }
+            Vec3D normalBefore = (before[1] - before[0]).crossProduct(before[2] - before[0]);
+            Vec3D normalAfter = (after[1] - after[0]).crossProduct(after[2] - after[0]);
+            if (normalBefore.dotProduct(normalAfter) <= 0.0f) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    IndexedMesh MeshSimplifier::simplify(IndexedMesh const &mesh, size_t targetTriangles, float maxError) {
+        SimplifierState state;
+        state.m_mesh = mesh;
+        state.m_fixedPositions = mesh.hasTexture() || mesh.hasNormals();
+
+        auto &indices = state.m_mesh.m_indices;
+        size_t numVertices = mesh.m_vertices.size();
+        size_t numTriangles = mesh.getTriangleCount();
+
+        state.m_quadrics.resize(numVertices);
+        state.m_vertexTriangles.resize(numVertices);
+        state.m_versions.assign(numVertices, 0);
+        state.m_removedVertices.assign(numVertices, false);
+        state.m_removedTriangles.assign(numTriangles, false);
+
+        // How many triangles use every edge - edges used once are on border
+        std::unordered_map<uint64_t, uint32_t> edgeUses;
+        auto edgeKey = [](uint32_t a, uint32_t b) {
+            return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+        };
+
+        // Every vertex starts with planes of its triangles
+        for (size_t t = 0; t < numTriangles; ++t) {
+            uint32_t const *tri = &indices[t * 3];
+            Vec3D p0 = state.getPosition(tri[0]);
+            Vec3D normal = (state.getPosition(tri[1]) - p0).crossProduct(state.getPosition(tri[2]) - p0);
+            if (normal.length() > 0.0f) {
+                normal.normalize();
+                Quadric q = Quadric::fromPlane(normal.m_x, normal.m_y, normal.m_z, -normal.dotProduct(p0), 1.0);
+                for (int i = 0; i < 3; ++i) {
+                    state.m_quadrics[tri[i]] += q;
+                }
+            }
+            for (int i = 0; i < 3; ++i) {
+                state.m_vertexTriangles[tri[i]].push_back(static_cast<uint32_t>(t));
+                ++edgeUses[edgeKey(tri[i], tri[(i + 1) % 3])];
+            }
+        }
+
+        // Border edges get plane that is perpendicular to their triangle
+        for (size_t t = 0; t < numTriangles; ++t) {
+            uint32_t const *tri = &indices[t * 3];
+            Vec3D p0 = state.getPosition(tri[0]);
+            Vec3D normal = (state.getPosition(tri[1]) - p0).crossProduct(state.getPosition(tri[2]) - p0);
+            for (int i = 0; i < 3; ++i) {
+                uint32_t a = tri[i], b = tri[(i + 1) % 3];
+                if (edgeUses[edgeKey(a, b)] != 1) {
+                    continue;
+                }
+                Vec3D edgeNormal = (state.getPosition(b) - state.getPosition(a)).crossProduct(normal);
+                if (edgeNormal.length() > 0.0f) {
+                    edgeNormal.normalize();
+                    Quadric q = Quadric::fromPlane(edgeNormal.m_x, edgeNormal.m_y, edgeNormal.m_z, -edgeNormal.dotProduct(state.getPosition(a)), borderWeight);
+                    state.m_quadrics[a] += q;
+                    state.m_quadrics[b] += q;
+                }
+            }
+        }
+
+        std::priority_queue<EdgeCollapse, std::vector<EdgeCollapse>, std::greater<EdgeCollapse>> queue;
+        for (auto const &edge : edgeUses) {
+            queue.push(makeCollapse(state, static_cast<uint32_t>(edge.first >> 32), static_cast<uint32_t>(edge.first & 0xFFFFFFFF)));
+        }
+
+        size_t aliveTriangles = numTriangles;
+        while (aliveTriangles > targetTriangles && !queue.empty()) {
+            EdgeCollapse collapse = queue.top();
+            queue.pop();
+
+            uint32_t from = collapse.m_from, to = collapse.m_to;
+            if (state.m_removedVertices[from] || state.m_removedVertices[to] ||
+                state.m_versions[from] != collapse.m_fromVersion || state.m_versions[to] != collapse.m_toVersion) {
+                continue;
+            }
+            if (collapse.m_error > maxError) {
+                break;
+            }
+            if (flipsTriangles(state, from, to, collapse.m_position) || flipsTriangles(state, to, from, collapse.m_position)) {
+                continue;
+            }
+
+            // "from" is merged into "to"
+            state.m_mesh.m_vertices.set(to, collapse.m_position);
+            if (collapse.m_keepFromAttributes) {
+                if (state.m_mesh.hasTexture()) {
+                    state.m_mesh.m_textures[to] = state.m_mesh.m_textures[from];
+                }
+                if (state.m_mesh.hasNormals()) {
+                    state.m_mesh.m_normals[to] = state.m_mesh.m_normals[from];
+                }
+            }
+            state.m_quadrics[to] += state.m_quadrics[from];
+            state.m_removedVertices[from] = true;
+            ++state.m_versions[to];
+
+            for (uint32_t t : state.m_vertexTriangles[from]) {
+                if (state.m_removedTriangles[t]) {
+                    continue;
+                }
+                uint32_t *tri = &indices[t * 3];
+                if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                    // Triangle had collapsed edge - it becomes a line
+                    state.m_removedTriangles[t] = true;
+                    --aliveTriangles;
+                    continue;
+                }
+                for (int i = 0; i < 3; ++i) {
+                    tri[i] = tri[i] == from ? to : tri[i];
+                }
+                state.m_vertexTriangles[to].push_back(t);
+            }
+            state.m_vertexTriangles[from].clear();
+
+            // Remove dead triangles from list and queue edges to all neighbours again
+            auto &triangles = state.m_vertexTriangles[to];
+            size_t numAlive = 0;
+            for (uint32_t t : triangles) {
+                if (state.m_removedTriangles[t]) {
+                    continue;
+                }
+                triangles[numAlive++] = t;
+                uint32_t const *tri = &indices[t * 3];
+                for (int i = 0; i < 3; ++i) {
+                    if (tri[i] != to) {
+                        queue.push(makeCollapse(state, tri[i], to));
+                    }
+                }
+            }
+            triangles.resize(numAlive);
+        }
+
+        // Only triangles that are left, unused vertices are removed
+        IndexedMesh &res = state.m_mesh;
+        std::vector<uint32_t> alive;
+        alive.reserve(aliveTriangles * 3);
+        for (size_t t = 0; t < numTriangles; ++t) {
+            if (!state.m_removedTriangles[t]) {
+                alive.insert(alive.end(), &indices[t * 3], &indices[t * 3] + 3);
+            }
+        }
+        res.m_indices = std::move(alive);
+        MeshOptimizer::optimizeVertexCache(res);
+        MeshOptimizer::optimizeVertexFetch(res);
+        return std::move(res);
+    }
+
+} // GE
@@ -0,0 +1,290 @@
+#include "ObjParser.hpp"
+#include "MappedFile.hpp"
+#include <charconv>
+#include <thread>
+
+namespace GE {
+
+    size_t ObjData::getTriangleCount() const {
+        return m_corners.size() / 3;
+    }
+
+    // Files smaller than this are parsed on one thread
+    static constexpr size_t parallelParseSize = 1 << 20;
+
+    // Result of parsing one part of file
+    // Relative indices can point into previous parts, they are resolved after all parts are parsed
+    struct ObjChunk {
+        ObjData m_data;
+
+        // Bit 0, 1, 2 - position, texture or normal index of corner is relative to start of this part
+        std::vector<uint8_t> m_relative;
+
+        bool m_ok = true;
+    };
+
+    static bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    static char const *skipBlanks(char const *cur, char const *end) {
+        while (cur < end && isBlank(*cur)) {
+            ++cur;
+        }
+        return cur;
+    }
+
+    static char const *skipLine(char const *cur, char const *end) {
+        while (cur < end && *cur != '\n') {
+            ++cur;
+        }
+        return cur < end ? cur + 1 : end;
+    }
+
+    static char const *readFloat(char const *cur, char const *end, float &val) {
+        cur = skipBlanks(cur, end);
+        if (cur < end && *cur == '+') {
+            ++cur;
+        }
+        auto res = std::from_chars(cur, end, val);
+        return res.ec == std::errc() ? res.ptr : nullptr;
+    }
+
+    static char const *readInt(char const *cur, char const *end, int32_t &val) {
+        if (cur < end && *cur == '+') {
+            ++cur;
+        }
+        auto res = std::from_chars(cur, end, val);
+        return res.ec == std::errc() ? res.ptr : nullptr;
+    }
+
+    // Turns index from file into index in array of count elements
+    // Negative index counts from last element read so far
+    static int32_t resolveIndex(int32_t index, size_t count, uint8_t &relative, uint8_t bit) {
+        if (index > 0) {
+            return index - 1;
+        }
+        relative |= bit;
+        return static_cast<int32_t>(count) + index;
+    }
+
+    // Reads corners of one face: a, a/b, a//c or a/b/c
+    static bool readFace(char const *cur, char const *end, ObjChunk &chunk) {
+        ObjData &data = chunk.m_data;
+        ObjData::Corner corners[3];
+        uint8_t relative[3];
+        int numCorners = 0;
+
+        while (true) {
+            cur = skipBlanks(cur, end);
+            if (cur >= end || *cur == '\n' || *cur == '#') {
+                break;
+            }
+
+            ObjData::Corner corner{ -1, -1, -1 };
+            uint8_t rel = 0;
+            int32_t index = 0;
+
+            if (!(cur = readInt(cur, end, index)) || index == 0) {
+                return false;
+            }
+            corner.m_position = resolveIndex(index, data.m_positions.size(), rel, 1);
+
+            if (cur < end && *cur == '/') {
+                ++cur;
+                if (cur < end && *cur != '/') {
+                    if (!(cur = readInt(cur, end, index)) || index == 0) {
+                        return false;
+                    }
+                    corner.m_texture = resolveIndex(index, data.m_textures.size(), rel, 2);
+                }
+                if (cur < end && *cur == '/') {
+                    ++cur;
+                    if (!(cur = readInt(cur, end, index)) || index == 0) {
+                        return false;
+                    }
+                    corner.m_normal = resolveIndex(index, data.m_normals.size(), rel, 4);
+                }
+            }
+
+            // Polygon is split into triangle fan around first corner
+            if (numCorners < 3) {
+                corners[numCorners] = corner;
+                relative[numCorners] = rel;
+            }
+            else {
+                corners[1] = corners[2];
+                relative[1] = relative[2];
+                corners[2] = corner;
+                relative[2] = rel;
+            }
+            ++numCorners;
+
+            if (numCorners >= 3) {
+                for (int i = 0; i < 3; ++i) {
+                    data.m_corners.push_back(corners[i]);
+                    chunk.m_relative.push_back(relative[i]);
+                }
+            }
+        }
+        return numCorners >= 3;
+    }
+
+    static void parseChunk(char const *cur, char const *end, ObjChunk &chunk) {
+        ObjData &data = chunk.m_data;
+        while (cur < end) {
+            cur = skipBlanks(cur, end);
+            if (cur >= end) {
+                break;
+            }
+            char const *lineEnd = cur;
+            while (lineEnd < end && *lineEnd != '\n') {
+                ++lineEnd;
+            }
+
+            if (cur[0] == 'v' && cur + 1 < lineEnd && isBlank(cur[1])) {
+                Vec3D v{};
+                char const *p = cur + 1;
+                if (!(p = readFloat(p, lineEnd, v.m_x)) || !(p = readFloat(p, lineEnd, v.m_y)) || !(p = readFloat(p, lineEnd, v.m_z))) {
+                    chunk.m_ok = false;
+                    return;
+                }
+                data.m_positions.push_back(v);
+            }
+            else if (cur[0] == 'v' && cur + 2 < lineEnd && cur[1] == 't' && isBlank(cur[2])) {
+                Vec2D v{};
+                char const *p = cur + 2;
+                if (!(p = readFloat(p, lineEnd, v.m_u))) {
+                    chunk.m_ok = false;
+                    return;
+                }
+                // Second coordinate is optional
+                if (!readFloat(p, lineEnd, v.m_v)) {
+                    v.m_v = 0.0f;
+                }
+                data.m_textures.push_back(v);
+            }
+            else if (cur[0] == 'v' && cur + 2 < lineEnd && cur[1] == 'n' && isBlank(cur[2])) {
+                Vec3D v{};
+                char const *p = cur + 2;
+                if (!(p = readFloat(p, lineEnd, v.m_x)) || !(p = readFloat(p, lineEnd, v.m_y)) || !(p = readFloat(p, lineEnd, v.m_z))) {
+                    chunk.m_ok = false;
+                    return;
+                }
+                v.m_w = 0.0f;
+                data.m_normals.push_back(v);
+            }
+            else if (cur[0] == 'f' && cur + 1 < lineEnd && isBlank(cur[1])) {
+                if (!readFace(cur + 1, lineEnd, chunk)) {
+                    chunk.m_ok = false;
+                    return;
+                }
+            }
+            cur = skipLine(lineEnd, end);
+        }
+    }
+
+    // Joins parsed parts into one result, relative indices get offset of their part
+    static bool mergeChunks(std::vector<ObjChunk> &chunks, ObjData &out) {
+        size_t numPositions = 0, numTextures = 0, numNormals = 0, numCorners = 0;
+        for (auto const &chunk : chunks) {
+            if (!chunk.m_ok) {
+                return false;
+            }
+            numPositions += chunk.m_data.m_positions.size();
+            numTextures += chunk.m_data.m_textures.size();
+            numNormals += chunk.m_data.m_normals.size();
+            numCorners += chunk.m_data.m_corners.size();
+        }
+
+        out = ObjData{};
+        out.m_positions.reserve(numPositions);
+        out.m_textures.reserve(numTextures);
+        out.m_normals.reserve(numNormals);
+        out.m_corners.reserve(numCorners);
+
+        for (auto &chunk : chunks) {
+            int32_t positionOffset = static_cast<int32_t>(out.m_positions.size());
+            int32_t textureOffset = static_cast<int32_t>(out.m_textures.size());
+            int32_t normalOffset = static_cast<int32_t>(out.m_normals.size());
+
+            out.m_positions.insert(out.m_positions.end(), chunk.m_data.m_positions.begin(), chunk.m_data.m_positions.end());
+            out.m_textures.insert(out.m_textures.end(), chunk.m_data.m_textures.begin(), chunk.m_data.m_textures.end());
+            out.m_normals.insert(out.m_normals.end(), chunk.m_data.m_normals.begin(), chunk.m_data.m_normals.end());
+
+            for (size_t i = 0; i < chunk.m_data.m_corners.size(); ++i) {
+                ObjData::Corner corner = chunk.m_data.m_corners[i];
+                uint8_t relative = chunk.m_relative[i];
+                if (relative & 1) {
+                    corner.m_position += positionOffset;
+                }
+                if (relative & 2) {
+                    corner.m_texture += textureOffset;
+                }
+                if (relative & 4) {
+                    corner.m_normal += normalOffset;
+                }
+                // Relative index that points before start of file
+                if (((relative & 2) && corner.m_texture < 0) || ((relative & 4) && corner.m_normal < 0)) {
+                    return false;
+                }
+                out.m_corners.push_back(corner);
+            }
+        }
+
+        // Indices must point to existing elements
+        for (auto const &corner : out.m_corners) {
+            if (corner.m_position < 0 || corner.m_position >= static_cast<int32_t>(out.m_positions.size()) ||
+                corner.m_texture >= static_cast<int32_t>(out.m_textures.size()) ||
+                corner.m_normal >= static_cast<int32_t>(out.m_normals.size())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ObjParser::parseFile(std::string const &path, ObjData &out) {
+        MappedFile file;
+        if (!file.open(path)) {
+            return false;
+        }
+        return parse(file.data(), file.data() + file.size(), out);
+    }
+
+    bool ObjParser::parse(char const *begin, char const *end, ObjData &out) {
+        size_t size = static_cast<size_t>(end - begin);
+        size_t numChunks = 1;
+        if (size >= parallelParseSize) {
+            size_t numThreads = std::thread::hardware_concurrency();
+            size_t maxChunks = size / (parallelParseSize / 4);
+            numChunks = numThreads < maxChunks ? numThreads : maxChunks;
+            numChunks = numChunks ? numChunks : 1;
+        }
+
+        // Parts are split at line starts
+        std::vector<char const *> bounds{ begin };
+        for (size_t i = 1; i < numChunks; ++i) {
+            char const *split = begin + size * i / numChunks;
+            split = split > bounds.back() ? skipLine(split - 1, end) : bounds.back();
+            bounds.push_back(split);
+        }
+        bounds.push_back(end);
+
+        std::vector<ObjChunk> chunks(numChunks);
+        if (numChunks == 1) {
+            parseChunk(begin, end, chunks[0]);
+        }
+        else {
+            std::vector<std::thread> threads;
+            for (size_t i = 1; i < numChunks; ++i) {
+                threads.emplace_back(parseChunk, bounds[i], bounds[i + 1], std::ref(chunks[i]));
+            }
+            parseChunk(bounds[0], bounds[1], chunks[0]);
+            for (auto &thread : threads) {
+                thread.join();
+            }
+        }
+        return mergeChunks(chunks, out);
+    }
+
+} // GE
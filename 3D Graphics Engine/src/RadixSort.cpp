@@ -0,0 +1,115 @@
+#include "RadixSort.hpp"
+#include <cstring>
+#include <utility>
+
+namespace GE {
+
+    // Arrays smaller than this are sorted on one thread - starting jobs would cost more than sorting
+    static constexpr size_t parallelSortThreshold = 16384;
+
+    static constexpr int radixBits = 8;
+    static constexpr int radixSize = 1 << radixBits;
+
+    // One pass over digit that starts at m_shift, every task works on its own block of keys
+    struct RadixPass {
+        SortKey *m_src;
+        SortKey *m_dst;
+        uint32_t *m_counts;
+        size_t m_count;
+        size_t m_blockSize;
+        int m_shift;
+
+        void count(int task) const {
+            uint32_t *counts = m_counts + static_cast<size_t>(task) * radixSize;
+            std::memset(counts, 0, sizeof(uint32_t) * radixSize);
+            size_t begin = task * m_blockSize;
+            size_t end = begin + m_blockSize < m_count ? begin + m_blockSize : m_count;
+            for (size_t i = begin; i < end; ++i) {
+                ++counts[(m_src[i].m_key >> m_shift) & (radixSize - 1)];
+            }
+        }
+
+        void scatter(int task) const {
+            uint32_t *offsets = m_counts + static_cast<size_t>(task) * radixSize;
+            size_t begin = task * m_blockSize;
+            size_t end = begin + m_blockSize < m_count ? begin + m_blockSize : m_count;
+            for (size_t i = begin; i < end; ++i) {
+                m_dst[offsets[(m_src[i].m_key >> m_shift) & (radixSize - 1)]++] = m_src[i];
+            }
+        }
+    };
+
+    void RadixSorter::sort(std::vector<SortKey> &keys) {
+        sort(keys, nullptr, 1);
+    }
+
+    void RadixSorter::sort(std::vector<SortKey> &keys, ParallelFor const &parallelFor, int numTasks) {
+        size_t count = keys.size();
+        if (count < 2) {
+            return;
+        }
+        if (!parallelFor || count < parallelSortThreshold || numTasks < 2) {
+            numTasks = 1;
+        }
+
+        m_scratch.resize(count);
+        m_counts.resize(static_cast<size_t>(numTasks) * radixSize);
+
+        RadixPass pass{ keys.data(), m_scratch.data(), m_counts.data(), count, (count + numTasks - 1) / numTasks, 0 };
+        for (; pass.m_shift < 32; pass.m_shift += radixBits) {
+            // Every task counts digits in its own block
+            if (numTasks == 1) {
+                pass.count(0);
+            }
+            else {
+                parallelFor(numTasks, [&pass](int task) { pass.count(task); });
+            }
+
+            // Pass changes nothing if all keys have same digit
+            bool sameDigit = false;
+            for (int digit = 0; digit < radixSize && !sameDigit; ++digit) {
+                size_t total = 0;
+                for (int task = 0; task < numTasks; ++task) {
+                    total += m_counts[static_cast<size_t>(task) * radixSize + digit];
+                }
+                sameDigit = total == count;
+            }
+            if (sameDigit) {
+                continue;
+            }
+
+            // Counts become offsets - smaller digits first, for same digit earlier blocks first so sort is stable
+            uint32_t offset = 0;
+            for (int digit = 0; digit < radixSize; ++digit) {
+                for (int task = 0; task < numTasks; ++task) {
+                    uint32_t &c = m_counts[static_cast<size_t>(task) * radixSize + digit];
+                    uint32_t n = c;
+                    c = offset;
+                    offset += n;
+                }
+            }
+
+            if (numTasks == 1) {
+                pass.scatter(0);
+            }
+            else {
+                parallelFor(numTasks, [&pass](int task) { pass.scatter(task); });
+            }
+            std::swap(pass.m_src, pass.m_dst);
+        }
+
+        // After odd number of passes result is in scratch buffer
+        if (pass.m_src != keys.data()) {
+            keys.swap(m_scratch);
+        }
+    }
+
+    uint32_t RadixSorter::floatKey(float val) {
+        // Bits of non negative float grow together with its value
+        val = val > 0.0f ? val : 0.0f;
+        uint32_t bits;
+        std::memcpy(&bits, &val, sizeof(bits));
+        return bits;
+    }
+
+} // GE
@@ -0,0 +1,18 @@
+#include "RenderTarget.hpp"
+#include <cmath>
+
+namespace GE {
+
+    // Fractional part that is always positive so texture repeats
+    static float wrapCoord(float c) {
+        float frac = std::modf(c, &c);
+        return std::signbit(frac) ? (1.0f + frac) : frac;
+    }
+
+    Cell Texture::sample(float u, float v) const {
+        int x = static_cast<int>(std::roundf(wrapCoord(u) * m_width)) % m_width;
+        int y = static_cast<int>(std::roundf(wrapCoord(v) * m_height)) % m_height;
+        return Cell{ m_pixels[y * m_width + x], m_colors[y * m_width + x] };
+    }
+
+} // GE
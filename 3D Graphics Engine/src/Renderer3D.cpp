@@ -0,0 +1,483 @@
+#include "Renderer3D.hpp"
+#include "TriangleRasterizer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace GE {
+
+    void Renderer3D::setDepthMode(DepthMode mode) {
+        m_depthMode = mode;
+    }
+
+    Renderer3D::DepthMode Renderer3D::getDepthMode() const {
+        return m_depthMode;
+    }
+
+    void Renderer3D::setShadeRamp(std::vector<Cell> const &ramp) {
+        if (!ramp.empty()) {
+            m_shadeRamp = ramp;
+        }
+    }
+
+    void Renderer3D::setLightDirection(Vec3D const &direction) {
+        m_lightDirection = direction.getNormalized();
+        m_lightDirection.m_w = 0.0f;
+    }
+
+    void Renderer3D::setAmbient(float ambient) {
+        m_ambient = ambient;
+    }
+
+    void Renderer3D::setParallelFor(ParallelFor parallelFor, int numThreads) {
+        m_parallelFor = std::move(parallelFor);
+        m_numThreads = numThreads;
+    }
+
+    void Renderer3D::beginFrame(Camera const &camera, RenderTarget const &target) {
+        m_camera = &camera;
+        m_target = target;
+        m_triangles.clear();
+        m_triangleTextures.clear();
+        m_textures.clear();
+        if (m_depthMode != DepthMode::Painter) {
+            m_depth.resize(target.m_width, target.m_height);
+            m_depth.clear();
+        }
+        if (m_depthMode == DepthMode::Deferred) {
+            // Cells are valid only where depth buffer was written, so they are never cleared
+            m_visibleTriangles.resize(static_cast<size_t>(target.m_width) * target.m_height);
+            m_visibleTextures.resize(static_cast<size_t>(target.m_width) * target.m_height);
+        }
+    }
+
+    void Renderer3D::submit(IndexedMesh const &mesh, Matrix4x4 const &model, MeshBVH const *bvh) {
+        submitMesh(mesh, model, model.getInverse(), -1, bvh);
+    }
+
+    void Renderer3D::submit(IndexedMesh const &mesh, Matrix4x4 const &model, Texture const &texture, MeshBVH const *bvh) {
+        m_textures.push_back(texture);
+        submitMesh(mesh, model, model.getInverse(), static_cast<int>(m_textures.size() - 1), bvh);
+    }
+
+    void Renderer3D::submit(MeshInstances const &instances) {
+        submitInstances(instances, -1);
+    }
+
+    void Renderer3D::submit(MeshInstances const &instances, Texture const &texture) {
+        m_textures.push_back(texture);
+        submitInstances(instances, static_cast<int>(m_textures.size() - 1));
+    }
+
+    void Renderer3D::submitInstances(MeshInstances const &instances, int texture) {
+        // Boxes of instances are in world space, so frustum is taken from camera view projection
+        m_visibleInstances.clear();
+        instances.cull(Frustum::fromMatrix(m_camera->getViewProjection()), m_visibleInstances);
+        for (MeshInstances::Visible const &visible : m_visibleInstances) {
+            // Mesh of instance that is whole in view doesn't need its parts culled
+            MeshBVH const *bvh = visible.m_inside ? nullptr : instances.getBVH();
+            submitMesh(instances.getMesh(), instances.getModel(visible.m_index), instances.getModelInverse(visible.m_index), texture, bvh);
+        }
+    }
+
+    // Calls fn(first, count) for part task of numTasks of elements listed by ranges, parts have equal size
+    template<typename GetFirst, typename GetCount, typename Fn>
+    static void forEachSlice(std::vector<MeshBVH::Range> const &ranges, int task, int numTasks, GetFirst getFirst, GetCount getCount, Fn fn) {
+        size_t total = 0;
+        for (MeshBVH::Range const &range : ranges) {
+            total += getCount(range);
+        }
+        size_t begin = total * task / numTasks;
+        size_t end = total * (task + 1) / numTasks;
+        size_t offset = 0;
+        for (MeshBVH::Range const &range : ranges) {
+            size_t count = getCount(range);
+            size_t from = begin > offset ? begin - offset : 0;
+            size_t to = end - offset < count ? end - offset : count;
+            if (from < to) {
+                fn(getFirst(range) + from, to - from);
+            }
+            offset += count;
+            if (offset >= end) {
+                break;
+            }
+        }
+    }
+
+    void Renderer3D::submitMesh(IndexedMesh const &mesh, Matrix4x4 const &model, Matrix4x4 const &modelInverse, int texture, MeshBVH const *bvh) {
+        if (mesh.m_faceNormals.size() != mesh.getTriangleCount()) {
+            return;
+        }
+        MeshJob job;
+        job.m_mesh = &mesh;
+        job.m_texture = texture >= 0 && mesh.hasTexture() ? texture : -1;
+        job.m_modelViewProjection = model.multiplyMatrix(m_camera->getViewProjection());
+
+        // Camera and light are moved to model space so stored normals can be used
+        job.m_cameraPosition = modelInverse.multiplyVector(m_camera->getPosition());
+        job.m_lightDirection = modelInverse.multiplyVector(m_lightDirection).getNormalized();
+
+        // Parts of mesh that can be visible, BVH is in model space so frustum is moved there too
+        m_ranges.clear();
+        if (bvh) {
+            bvh->cull(Frustum::fromMatrix(job.m_modelViewProjection), m_ranges);
+        }
+        else {
+            m_ranges.push_back(MeshBVH::Range{ 0, static_cast<uint32_t>(mesh.getTriangleCount()), 0, static_cast<uint32_t>(mesh.m_vertices.size()) });
+        }
+
+        // Vertex ranges of nodes can share vertices, they are merged so every vertex is transformed once
+        // and vertices of different tasks never overlap
+        m_vertexRanges.assign(m_ranges.begin(), m_ranges.end());
+        std::sort(m_vertexRanges.begin(), m_vertexRanges.end(), [](MeshBVH::Range const &a, MeshBVH::Range const &b) {
+            return a.m_firstVertex < b.m_firstVertex;
+        });
+        size_t merged = 0;
+        for (size_t i = 1; i < m_vertexRanges.size(); ++i) {
+            MeshBVH::Range &last = m_vertexRanges[merged];
+            MeshBVH::Range const &range = m_vertexRanges[i];
+            uint32_t lastEnd = last.m_firstVertex + last.m_vertexCount;
+            if (range.m_firstVertex <= lastEnd) {
+                uint32_t rangeEnd = range.m_firstVertex + range.m_vertexCount;
+                last.m_vertexCount = (lastEnd > rangeEnd ? lastEnd : rangeEnd) - last.m_firstVertex;
+            }
+            else {
+                m_vertexRanges[++merged] = range;
+            }
+        }
+        m_vertexRanges.resize(m_vertexRanges.empty() ? 0 : merged + 1);
+
+        size_t numVertices = mesh.m_vertices.size();
+        m_clipVertices.resize(numVertices);
+        m_outcodes.resize(numVertices);
+        m_guardOutcodes.resize(numVertices);
+
+        size_t visibleTriangles = 0;
+        for (MeshBVH::Range const &range : m_ranges) {
+            visibleTriangles += range.m_triangleCount;
+        }
+
+        // Small meshes are not worth waking other threads
+        if (!m_parallelFor || m_numThreads < 2 || visibleTriangles < minParallelTriangles) {
+            for (MeshBVH::Range const &range : m_vertexRanges) {
+                transformVertices(job, range.m_firstVertex, range.m_vertexCount);
+            }
+            for (MeshBVH::Range const &range : m_ranges) {
+                processTriangles(job, range.m_firstTriangle, range.m_triangleCount, m_triangles, m_triangleTextures);
+            }
+            return;
+        }
+
+        // Every task transforms its part of vertices, then its part of triangles into its own buffers
+        // Buffers are joined in task order so result is the same as with one thread
+        // Jobs capture only two pointers so std::function doesn't allocate
+        job.m_numTasks = m_numThreads;
+        if (m_taskTriangles.size() < static_cast<size_t>(job.m_numTasks)) {
+            m_taskTriangles.resize(job.m_numTasks);
+            m_taskTriangleTextures.resize(job.m_numTasks);
+        }
+        m_parallelFor(job.m_numTasks, [this, &job](int task) {
+            forEachSlice(m_vertexRanges, task, job.m_numTasks,
+                [](MeshBVH::Range const &r) { return static_cast<size_t>(r.m_firstVertex); },
+                [](MeshBVH::Range const &r) { return static_cast<size_t>(r.m_vertexCount); },
+                [&](size_t first, size_t count) { transformVertices(job, first, count); });
+        });
+        m_parallelFor(job.m_numTasks, [this, &job](int task) {
+            m_taskTriangles[task].clear();
+            m_taskTriangleTextures[task].clear();
+            forEachSlice(m_ranges, task, job.m_numTasks,
+                [](MeshBVH::Range const &r) { return static_cast<size_t>(r.m_firstTriangle); },
+                [](MeshBVH::Range const &r) { return static_cast<size_t>(r.m_triangleCount); },
+                [&](size_t first, size_t count) { processTriangles(job, first, count, m_taskTriangles[task], m_taskTriangleTextures[task]); });
+        });
+        for (int task = 0; task < job.m_numTasks; ++task) {
+            m_triangles.insert(m_triangles.end(), m_taskTriangles[task].begin(), m_taskTriangles[task].end());
+            m_triangleTextures.insert(m_triangleTextures.end(), m_taskTriangleTextures[task].begin(), m_taskTriangleTextures[task].end());
+        }
+    }
+
+    void Renderer3D::transformVertices(MeshJob const &job, size_t first, size_t count) {
+        // Model space -> clip space, each vertex of visible parts is transformed and classified once
+        job.m_modelViewProjection.multiplyStream(job.m_mesh->m_vertices, m_clipVertices, first, count);
+        for (size_t v = first; v < first + count; ++v) {
+            Vec3D position = m_clipVertices.get(v);
+            m_outcodes[v] = static_cast<uint8_t>(m_clipper.getOutcode(position));
+            m_guardOutcodes[v] = static_cast<uint8_t>(m_clipper.getGuardOutcode(position));
+        }
+    }
+
+    void Renderer3D::processTriangles(MeshJob const &job, size_t first, size_t count, std::vector<TexturedTriangle> &triangles, std::vector<int> &triangleTextures) const {
+        IndexedMesh const &mesh = *job.m_mesh;
+        bool textured = job.m_texture >= 0;
+        for (size_t t = first; t < first + count; ++t) {
+            uint32_t const *indices = &mesh.m_indices[t * 3];
+            Vec3D const &normal = mesh.m_faceNormals[t];
+
+            // Only side of triangle that looks at camera is drawn
+            if (normal.dotProduct(mesh.m_vertices.get(indices[0]) - job.m_cameraPosition) >= 0.0f) {
+                continue;
+            }
+
+            // Triangles completely outside of one plane are dropped before any clipping
+            uint32_t codes[3], guardCodes[3];
+            for (int i = 0; i < 3; ++i) {
+                codes[i] = m_outcodes[indices[i]];
+                guardCodes[i] = m_guardOutcodes[indices[i]];
+            }
+            bool rejected;
+            uint32_t planes = m_clipper.getClipPlanes(codes, guardCodes, rejected);
+            if (rejected) {
+                continue;
+            }
+
+            Cell cell{ 0, 0 };
+            if (!textured) {
+                float light = normal.dotProduct(job.m_lightDirection);
+                light = light > m_ambient ? light : m_ambient;
+                int level = static_cast<int>(light * static_cast<float>(m_shadeRamp.size()));
+                level = level < 0 ? 0 : (level >= static_cast<int>(m_shadeRamp.size()) ? static_cast<int>(m_shadeRamp.size()) - 1 : level);
+                cell = m_shadeRamp[level];
+            }
+
+            ClipVertex corners[3];
+            for (int i = 0; i < 3; ++i) {
+                corners[i].m_position = m_clipVertices.get(indices[i]);
+                corners[i].m_texture = textured ? mesh.m_textures[indices[i]] : Vec2D{ 0.0f, 0.0f };
+            }
+            if (planes == 0) {
+                addPolygon(corners, 3, cell, job.m_texture, triangles, triangleTextures);
+            }
+            else {
+                ClipVertex polygon[Clipper::maxVertices];
+                int numVertices = m_clipper.clipTriangle(corners, planes, polygon);
+                addPolygon(polygon, numVertices, cell, job.m_texture, triangles, triangleTextures);
+            }
+        }
+    }
+
+    void Renderer3D::addPolygon(ClipVertex const *polygon, int count, Cell cell, int texture, std::vector<TexturedTriangle> &triangles, std::vector<int> &triangleTextures) const {
+        if (count < 3) {
+            return;
+        }
+
+        // Every vertex is divided by w once, polygon is split into fan of triangles
+        float halfWidth = 0.5f * static_cast<float>(m_target.m_width);
+        float halfHeight = 0.5f * static_cast<float>(m_target.m_height);
+        TexturedTriangle projected;
+        projected.m_pixel = cell.m_pixel;
+        projected.m_color = cell.m_color;
+        Vec3D screen[Clipper::maxVertices];
+        Vec2D textures[Clipper::maxVertices];
+        for (int i = 0; i < count; ++i) {
+            Vec3D const &v = polygon[i].m_position;
+            float invW = 1.0f / v.m_w;
+
+            // Normalized coordinates [-1; +1] -> cells, y axis points down on screen
+            screen[i] = Vec3D{ (v.m_x * invW + 1.0f) * halfWidth, (1.0f - v.m_y * invW) * halfHeight, v.m_z * invW };
+
+            // Texture coordinates divided by w are interpolated linearly on screen
+            textures[i] = Vec2D{ polygon[i].m_texture.m_u * invW, polygon[i].m_texture.m_v * invW, invW };
+        }
+        for (int i = 1; i + 1 < count; ++i) {
+            projected.m_vertices[0] = screen[0];
+            projected.m_vertices[1] = screen[i];
+            projected.m_vertices[2] = screen[i + 1];
+            projected.m_textures[0] = textures[0];
+            projected.m_textures[1] = textures[i];
+            projected.m_textures[2] = textures[i + 1];
+            triangles.push_back(projected);
+            triangleTextures.push_back(texture);
+        }
+    }
+
+    void Renderer3D::flush() {
+        m_order.resize(m_triangles.size());
+        for (size_t i = 0; i < m_order.size(); ++i) {
+            m_order[i] = SortKey{ 0, static_cast<uint32_t>(i) };
+        }
+        if (m_depthMode == DepthMode::Painter) {
+            // Farthest triangles are drawn first - key is inverted average depth
+            for (SortKey &key : m_order) {
+                TexturedTriangle const &t = m_triangles[key.m_index];
+                key.m_key = ~RadixSorter::floatKey((t.m_vertices[0].m_z + t.m_vertices[1].m_z + t.m_vertices[2].m_z) / 3.0f);
+            }
+            m_sorter.sort(m_order, m_parallelFor, m_numThreads);
+        }
+
+        // With one thread whole screen is one tile
+        if (!m_parallelFor || m_numThreads < 2) {
+            for (SortKey const &key : m_order) {
+                rasterize(key.m_index, 0, 0, m_target.m_width, m_target.m_height);
+            }
+            if (m_depthMode == DepthMode::Deferred) {
+                resolve(0, 0, m_target.m_width, m_target.m_height);
+            }
+            return;
+        }
+
+        m_tilesX = (m_target.m_width + tileSize - 1) / tileSize;
+        m_tilesY = (m_target.m_height + tileSize - 1) / tileSize;
+        int numTiles = m_tilesX * m_tilesY;
+        size_t numBins = static_cast<size_t>(m_numThreads) * numTiles;
+        if (m_tileBins.size() < numBins) {
+            m_tileBins.resize(numBins);
+        }
+
+        // Every task puts its part of drawing order into its own bins of tiles that triangle's bounding box touches
+        m_parallelFor(m_numThreads, [this, numTiles](int task) {
+            std::vector<uint32_t> *bins = &m_tileBins[static_cast<size_t>(task) * numTiles];
+            for (int tile = 0; tile < numTiles; ++tile) {
+                bins[tile].clear();
+            }
+            size_t begin = m_order.size() * task / m_numThreads;
+            size_t end = m_order.size() * (task + 1) / m_numThreads;
+            for (size_t i = begin; i < end; ++i) {
+                TexturedTriangle const &t = m_triangles[m_order[i].m_index];
+                float minX = t.m_vertices[0].m_x, maxX = minX, minY = t.m_vertices[0].m_y, maxY = minY;
+                for (int v = 1; v < 3; ++v) {
+                    minX = t.m_vertices[v].m_x < minX ? t.m_vertices[v].m_x : minX;
+                    maxX = t.m_vertices[v].m_x > maxX ? t.m_vertices[v].m_x : maxX;
+                    minY = t.m_vertices[v].m_y < minY ? t.m_vertices[v].m_y : minY;
+                    maxY = t.m_vertices[v].m_y > maxY ? t.m_vertices[v].m_y : maxY;
+                }
+                int firstX = static_cast<int>(std::floor(minX)) / tileSize, lastX = static_cast<int>(std::floor(maxX)) / tileSize;
+                int firstY = static_cast<int>(std::floor(minY)) / tileSize, lastY = static_cast<int>(std::floor(maxY)) / tileSize;
+                firstX = firstX > 0 ? firstX : 0;
+                firstY = firstY > 0 ? firstY : 0;
+                lastX = lastX < m_tilesX - 1 ? lastX : m_tilesX - 1;
+                lastY = lastY < m_tilesY - 1 ? lastY : m_tilesY - 1;
+                for (int y = firstY; y <= lastY; ++y) {
+                    for (int x = firstX; x <= lastX; ++x) {
+                        bins[y * m_tilesX + x].push_back(static_cast<uint32_t>(i));
+                    }
+                }
+            }
+        });
+
+        // Tiles don't share cells(and their part of depth buffer) so they are drawn in parallel
+        // Bins of tile are read in task order, which keeps drawing order
+        m_parallelFor(numTiles, [this, numTiles](int tile) {
+            int minX = (tile % m_tilesX) * tileSize;
+            int minY = (tile / m_tilesX) * tileSize;
+            int maxX = minX + tileSize < m_target.m_width ? minX + tileSize : m_target.m_width;
+            int maxY = minY + tileSize < m_target.m_height ? minY + tileSize : m_target.m_height;
+            for (int task = 0; task < m_numThreads; ++task) {
+                for (uint32_t i : m_tileBins[static_cast<size_t>(task) * numTiles + tile]) {
+                    rasterize(m_order[i].m_index, minX, minY, maxX, maxY);
+                }
+            }
+            if (m_depthMode == DepthMode::Deferred) {
+                resolve(minX, minY, maxX, maxY);
+            }
+        });
+    }
+
+    size_t Renderer3D::getTriangleCount() const {
+        return m_triangles.size();
+    }
+
+    void Renderer3D::rasterize(uint32_t index, int minX, int minY, int maxX, int maxY) {
+        TexturedTriangle const &triangle = m_triangles[index];
+        Texture const *texture = m_triangleTextures[index] >= 0 ? &m_textures[m_triangleTextures[index]] : nullptr;
+
+        bool deferred = m_depthMode == DepthMode::Deferred;
+        bool depthTest = m_depthMode != DepthMode::Painter;
+        float *depth = nullptr;
+        if (depthTest) {
+            int x[3], y[3];
+            for (int i = 0; i < 3; ++i) {
+                x[i] = static_cast<int>(std::floor(triangle.m_vertices[i].m_x));
+                y[i] = static_cast<int>(std::floor(triangle.m_vertices[i].m_y));
+            }
+
+            // Cells triangle can cover inside of scissor rectangle
+            // Edge positions are truncated, rounding error can move them one cell left of leftmost corner
+            int left = x[0] < x[1] ? (x[0] < x[2] ? x[0] : x[2]) : (x[1] < x[2] ? x[1] : x[2]);
+            int right = x[0] > x[1] ? (x[0] > x[2] ? x[0] : x[2]) : (x[1] > x[2] ? x[1] : x[2]);
+            int top = y[0] < y[1] ? (y[0] < y[2] ? y[0] : y[2]) : (y[1] < y[2] ? y[1] : y[2]);
+            int bottom = y[0] > y[1] ? (y[0] > y[2] ? y[0] : y[2]) : (y[1] > y[2] ? y[1] : y[2]);
+            int boxMinX = left - 1 > minX ? left - 1 : minX;
+            int boxMaxX = right + 1 < maxX ? right + 1 : maxX;
+            int boxMinY = top > minY ? top : minY;
+            int boxMaxY = bottom + 1 < maxY ? bottom + 1 : maxY;
+            if (boxMinX >= boxMaxX || boxMinY >= boxMaxY) {
+                return;
+            }
+
+            // Depth changes linearly across triangle, so corners hold its nearest and farthest depth
+            float w0 = triangle.m_textures[0].m_w, w1 = triangle.m_textures[1].m_w, w2 = triangle.m_textures[2].m_w;
+            float nearest = w0 > w1 ? (w0 > w2 ? w0 : w2) : (w1 > w2 ? w1 : w2);
+            float farthest = w0 < w1 ? (w0 < w2 ? w0 : w2) : (w1 < w2 ? w1 : w2);
+            DepthBuffer::Visibility visibility = m_depth.test(boxMinX, boxMinY, boxMaxX, boxMaxY, nearest, farthest);
+            if (visibility == DepthBuffer::Visibility::Occluded) {
+                return;
+            }
+            m_depth.beginWrite(boxMinX, boxMinY, boxMaxX, boxMaxY, nearest);
+            depth = m_depth.getData();
+
+            // Triangle in front of whole rectangle still writes its depth, but cells are not tested
+            depthTest = visibility == DepthBuffer::Visibility::Partial;
+        }
+        Cell flat{ static_cast<uint16_t>(triangle.m_pixel), static_cast<uint16_t>(triangle.m_color) };
+
+        // Texture coordinates point to corner of texel, not its center
+        float offsetU = texture ? 0.5f / texture->m_width : 0.0f;
+        float offsetV = texture ? 0.5f / texture->m_height : 0.0f;
+
+        TriangleRasterizer::forEachSpan(triangle, minY, maxY, [&](int y, int ax, int bx, Vec2D const &start, Vec2D const &end) {
+            size_t row = static_cast<size_t>(y) * m_target.m_width;
+            TriangleRasterizer::forEachCell(ax, bx, start, end, minX, maxX, [&](int x, float u, float v, float w) {
+                if (depthTest && w <= depth[row + x]) {
+                    return;
+                }
+                if (depth) {
+                    depth[row + x] = w;
+                }
+                if (deferred) {
+                    // Only what is needed to shade cell later is stored
+                    m_visibleTriangles[row + x] = index;
+                    m_visibleTextures[row + x] = Vec2D{ u, v };
+                    return;
+                }
+                Cell cell = texture ? texture->sample(u - offsetU, v - offsetV) : flat;
+                m_target.m_pixels[row + x] = cell.m_pixel;
+                m_target.m_colors[row + x] = cell.m_color;
+            });
+        });
+    }
+
+    void Renderer3D::resolve(int minX, int minY, int maxX, int maxY) {
+        float const *depth = m_depth.getData();
+        for (int ty = minY / DepthBuffer::tileSize; ty <= (maxY - 1) / DepthBuffer::tileSize; ++ty) {
+            for (int tx = minX / DepthBuffer::tileSize; tx <= (maxX - 1) / DepthBuffer::tileSize; ++tx) {
+                // Nothing was drawn to tile, its cells hold values from older frames
+                if (m_depth.isTileCleared(tx, ty)) {
+                    continue;
+                }
+                int fromX = tx * DepthBuffer::tileSize > minX ? tx * DepthBuffer::tileSize : minX;
+                int toX = (tx + 1) * DepthBuffer::tileSize < maxX ? (tx + 1) * DepthBuffer::tileSize : maxX;
+                int fromY = ty * DepthBuffer::tileSize > minY ? ty * DepthBuffer::tileSize : minY;
+                int toY = (ty + 1) * DepthBuffer::tileSize < maxY ? (ty + 1) * DepthBuffer::tileSize : maxY;
+                for (int y = fromY; y < toY; ++y) {
+                    size_t row = static_cast<size_t>(y) * m_target.m_width;
+                    for (int x = fromX; x < toX; ++x) {
+                        if (depth[row + x] <= 0.0f) {
+                            continue;
+                        }
+                        uint32_t index = m_visibleTriangles[row + x];
+                        TexturedTriangle const &triangle = m_triangles[index];
+                        Cell cell{ static_cast<uint16_t>(triangle.m_pixel), static_cast<uint16_t>(triangle.m_color) };
+                        if (m_triangleTextures[index] >= 0) {
+                            // Same sampling as in rasterize
+                            Texture const &texture = m_textures[m_triangleTextures[index]];
+                            Vec2D const &uv = m_visibleTextures[row + x];
+                            cell = texture.sample(uv.m_u - 0.5f / texture.m_width, uv.m_v - 0.5f / texture.m_height);
+                        }
+                        m_target.m_pixels[row + x] = cell.m_pixel;
+                        m_target.m_colors[row + x] = cell.m_color;
+                    }
+                }
+            }
+        }
+    }
+
+} // GE
@@ -0,0 +1,72 @@
+#include "Transform.hpp"
+#include "Camera.hpp"
+
+namespace GE {
+
+    void Transform::setPosition(Vec3D const &position) {
+        m_position = position;
+        changed();
+    }
+
+    void Transform::move(Vec3D const &offset) {
+        m_position += offset;
+        changed();
+    }
+
+    Vec3D const &Transform::getPosition() const {
+        return m_position;
+    }
+
+    void Transform::setRotation(float angleX, float angleY, float angleZ) {
+        m_rotation = Vec3D{ angleX, angleY, angleZ };
+        changed();
+    }
+
+    Vec3D const &Transform::getRotation() const {
+        return m_rotation;
+    }
+
+    void Transform::setScale(float x, float y, float z) {
+        m_scale = Vec3D{ x, y, z };
+        changed();
+    }
+
+    Vec3D const &Transform::getScale() const {
+        return m_scale;
+    }
+
+    Matrix4x4 const &Transform::getMatrix() const {
+        if (m_matrixDirty) {
+            Matrix4x4 rotation = Matrix4x4::makeRotationZ(m_rotation.m_z);
+            rotation = rotation.multiplyMatrix(Matrix4x4::makeRotationX(m_rotation.m_x));
+            rotation = rotation.multiplyMatrix(Matrix4x4::makeRotationY(m_rotation.m_y));
+
+            m_matrix = Matrix4x4::makeScale(m_scale.m_x, m_scale.m_y, m_scale.m_z).multiplyMatrix(rotation);
+            m_matrix[3][0] = m_position.m_x;
+            m_matrix[3][1] = m_position.m_y;
+            m_matrix[3][2] = m_position.m_z;
+            m_matrixDirty = false;
+        }
+        return m_matrix;
+    }
+
+    Matrix4x4 const &Transform::getModelViewProjection(Camera const &camera) const {
+        if (m_mvpCamera != &camera || m_mvpCameraVersion != camera.getVersion() || m_mvpVersion != m_version) {
+            m_modelViewProjection = getMatrix().multiplyMatrix(camera.getViewProjection());
+            m_mvpCamera = &camera;
+            m_mvpCameraVersion = camera.getVersion();
+            m_mvpVersion = m_version;
+        }
+        return m_modelViewProjection;
+    }
+
+    unsigned Transform::getVersion() const {
+        return m_version;
+    }
+
+    void Transform::changed() {
+        ++m_version;
+        m_matrixDirty = true;
+    }
+
+} // GE
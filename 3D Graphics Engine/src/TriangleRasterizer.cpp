@@ -0,0 +1,25 @@
+#include "TriangleRasterizer.hpp"
+
+namespace GE {
+
+    void TriangleRasterizer::drawTextured(RenderTarget const &target, TexturedTriangle const &triangle, Texture const &texture, float *depth) {
+        // Texture coordinates point to corner of texel, not its center
+        float offsetU = 0.5f / texture.m_width;
+        float offsetV = 0.5f / texture.m_height;
+        forEachSpan(triangle, 0, target.m_height, [&](int y, int ax, int bx, Vec2D const &start, Vec2D const &end) {
+            size_t row = static_cast<size_t>(y) * target.m_width;
+            forEachCell(ax, bx, start, end, 0, target.m_width, [&](int x, float u, float v, float w) {
+                if (depth) {
+                    if (w <= depth[row + x]) {
+                        return;
+                    }
+                    depth[row + x] = w;
+                }
+                Cell cell = texture.sample(u - offsetU, v - offsetV);
+                target.m_pixels[row + x] = cell.m_pixel;
+                target.m_colors[row + x] = cell.m_color;
+            });
+        });
+    }
+
+} // GE
@@ -0,0 +1,29 @@
+#include "VertexStream.hpp"
+
+namespace GE {
+
+    void VertexStream::resize(size_t count) {
+        m_x.resize(count);
+        m_y.resize(count);
+        m_z.resize(count);
+        m_w.resize(count, 1.0f);
+    }
+
+    size_t VertexStream::size() const {
+        return m_x.size();
+    }
+
+    void VertexStream::set(size_t index, Vec3D const &v) {
+        m_x[index] = v.m_x;
+        m_y[index] = v.m_y;
+        m_z[index] = v.m_z;
+        m_w[index] = v.m_w;
+    }
+
+    Vec3D VertexStream::get(size_t index) const {
+        Vec3D v{ m_x[index], m_y[index], m_z[index] };
+        v.m_w = m_w[index];
+        return v;
+    }
+
+} // GE
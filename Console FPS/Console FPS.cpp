@@ -61,6 +61,9 @@ public:
 
         m_fDepthBuffer = std::make_unique<float[]>(m_screenWidth);
 
+        // Lower resolution of rendered image if frames take longer than 1/30 of a second
+        enableDynamicResolution(1.0f / 30.0f);
+
         return true;
 
     }
@@ -119,10 +122,15 @@ public:
             m_objects.emplace_back(0.0f, std::move(bullet));
         }
 
+        // Image can be rendered in lower resolution than console size
+        // when frames take too long - draw using size of rendered image
+        short renderWidth = getRenderWidth();
+        short renderHeight = getRenderHeight();
+
         // For each column on screen we do calculations
-        for (int x = 0; x < m_screenWidth; ++x) {
+        for (int x = 0; x < renderWidth; ++x) {
             // Calculating angle at which player looks at "pixel column"
-            float fRayAngle = (m_fPlayerA - (m_fPlayerFOV / 2.0f)) + (static_cast<float>(x) * (m_fPlayerFOV / static_cast<float>(m_screenWidth)));
+            float fRayAngle = (m_fPlayerA - (m_fPlayerFOV / 2.0f)) + (static_cast<float>(x) * (m_fPlayerFOV / static_cast<float>(renderWidth)));
 
             // Flag for drawing wall
             bool bHitWall = false;
@@ -200,11 +208,11 @@ public:
 
             // Distance between floor and ceiling
             // The bigger the distance to wall, the bigger floor and ceiling appear
-            int nCeiling = static_cast<int>(static_cast<float>(m_screenHeight / 2.0f) - m_screenHeight / static_cast<float>(fDistanceToWall));
-            int nFloor = m_screenHeight - nCeiling;
+            int nCeiling = static_cast<int>(static_cast<float>(renderHeight / 2.0f) - renderHeight / static_cast<float>(fDistanceToWall));
+            int nFloor = renderHeight - nCeiling;
 
             // Cycle for rendering column
-            for (int y = 0; y < m_screenHeight; ++y) {
+            for (int y = 0; y < renderHeight; ++y) {
                 // If ceiling we just leave it black
                 if (y < nCeiling) {
                     draw(x, y, CGE::Pixel::Empty, CGE::Color::FG_Black);
@@ -225,7 +233,7 @@ public:
                 else {
                     // Drawing the floor
                     // The more distance to floor, the darker it appears
-                    float fFloorShadeCoef = 1.0f - (static_cast<float>(y) - m_screenHeight / 2.0f) / (static_cast<float>(m_screenHeight) / 2.0f);
+                    float fFloorShadeCoef = 1.0f - (static_cast<float>(y) - renderHeight / 2.0f) / (static_cast<float>(renderHeight) / 2.0f);
                     short nShade = getFloorShade(fFloorShadeCoef);
                     draw(x, y, nShade, CGE::Color::FG_DarkGreen);
                 }
@@ -280,14 +288,14 @@ public:
             // If player can see object we render it
             if (isInPlayerFOV) {
                 // Calculating size of ceiling and floor above and below object by distance to object
-                float fObjectCeiling = (m_screenHeight / 2.0f) - (m_screenHeight / distanceToPlayer);
-                float fObjectFloor = m_screenHeight - fObjectCeiling;
+                float fObjectCeiling = (renderHeight / 2.0f) - (renderHeight / distanceToPlayer);
+                float fObjectFloor = renderHeight - fObjectCeiling;
                 float fObjectHeight = fObjectFloor - fObjectCeiling;
 
                 // Calculating dimensions of object - the farer it is the smaller it appears
                 float fObjectAspectRatio = static_cast<float>(obj.second.s.getHeight()) / static_cast<float>(obj.second.s.getWidth());
                 float fObjectWidth = fObjectHeight / fObjectAspectRatio;
-                float fObjectMiddle = (0.5f * (fObjAngle / (m_fPlayerFOV / 2.0f)) + 0.5f) * static_cast<float>(m_screenWidth);
+                float fObjectMiddle = (0.5f * (fObjAngle / (m_fPlayerFOV / 2.0f)) + 0.5f) * static_cast<float>(renderWidth);
 
                 // Rendering object using sampling
                 for (float lx = 0.0f; lx < fObjectWidth; ++lx) {
@@ -296,7 +304,7 @@ public:
                         float fSampleY = ly / fObjectHeight;
                         CGE::basePixelType c = obj.second.s.samplePixel(fSampleX, fSampleY);
                         int nObjColumn = static_cast<int>(fObjectMiddle - (fObjectWidth / 2.0f) + lx);
-                        if (nObjColumn >= 0.0f && nObjColumn < m_screenWidth) {
+                        if (nObjColumn >= 0.0f && nObjColumn < renderWidth) {
                             // Drawing object taking into consideration transparency of its parts
                             if (c != CGE::Pixel::Empty && m_fDepthBuffer[nObjColumn] >= distanceToPlayer) {
                                 draw(static_cast<short>(nObjColumn), static_cast<short>(fObjectCeiling + ly), c, obj.second.s.sampleColor(fSampleX, fSampleY));
@@ -312,15 +320,18 @@ public:
         // Deleting "marked" objects
         m_objects.remove_if([](auto const &p) { return p.second.doRemove == true; });
 
+        return true;
+    }
+
+    // Level map is drawn after image is stretched to console, so it isn't scaled with dynamic resolution
+    void userDrawHUD() override {
         // Printing level map at the top left corner
         for (int nx = 0; nx < m_nMapWidth; ++nx) {
             for (int ny = 0; ny < m_nMapHeight; ++ny) {
-                draw(nx, ny, static_cast<CGE::Pixel>(m_map[ny * m_nMapWidth + nx]), CGE::Color::FG_White);
+                drawHUD(nx, ny, static_cast<CGE::Pixel>(m_map[ny * m_nMapWidth + nx]), CGE::Color::FG_White);
             }
         }
-        draw(static_cast<int>(m_fPlayerX), static_cast<int>(m_fPlayerY), static_cast<CGE::Pixel>(L'P'), CGE::Color::FG_White);
-
-        return true;
+        drawHUD(static_cast<int>(m_fPlayerX), static_cast<int>(m_fPlayerY), static_cast<CGE::Pixel>(L'P'), CGE::Color::FG_White);
     }
 
 private:
@@ -20,6 +20,8 @@ VS: Project Properties -> General -> Character Set -> Use Unicode
 
 #include <iostream>
 #include <string>
+#include <algorithm>
+#include <vector>
 #include <cstdio>
 #include <cmath>
 #include <memory>
@@ -27,6 +29,7 @@ VS: Project Properties -> General -> Character Set -> Use Unicode
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
 
 namespace CGE {
 
@@ -95,10 +98,7 @@ namespace CGE {
             m_height = 8;
             m_pixels = std::make_unique<basePixelType[]>(m_width * m_height);
             m_colors = std::make_unique<baseColorType[]>(m_width * m_height);
-            for (short i = 0; i < m_width * m_height; ++i) {
-                m_pixels[i] = Pixel::Empty;
-                m_colors[i] = Color::FG_Black;
-            }
+            clear(Pixel::Empty, Color::FG_Black);
         }
 
         // Blank Sprite instance
@@ -110,10 +110,7 @@ namespace CGE {
             m_height = height;
             m_pixels = std::make_unique<basePixelType[]>(m_width * m_height);
             m_colors = std::make_unique<baseColorType[]>(m_width * m_height);
-            for (short i = 0; i < m_width * m_height; ++i) {
-                m_pixels[i] = Pixel::Empty;
-                m_colors[i] = Color::FG_Black;
-            }
+            clear(Pixel::Empty, Color::FG_Black);
         }
 
         // Reading Sprite data from binary file
@@ -131,6 +128,10 @@ namespace CGE {
         ( Sprite &&s
         ) noexcept = default;
 
+        Sprite &operator=
+        ( Sprite &&s
+        ) noexcept = default;
+
         short getWidth
         (
         ) const {
@@ -219,6 +220,41 @@ namespace CGE {
             return getColor(x, y);
         }
 
+        // Sets every pixel of a sprite to same value
+        void clear
+        ( basePixelType p = Pixel::Empty
+        , baseColorType c = Color::FG_Black
+        ) {
+            std::fill_n(m_pixels.get(), m_width * m_height, p);
+            std::fill_n(m_colors.get(), m_width * m_height, c);
+        }
+
+        // Raw access to sprite planes - row by row, m_width values in each row
+        // Used by Canvas to write into sprite without per pixel checks
+        basePixelType *getPixelData
+        (
+        ) {
+            return m_pixels.get();
+        }
+
+        basePixelType const *getPixelData
+        (
+        ) const {
+            return m_pixels.get();
+        }
+
+        baseColorType *getColorData
+        (
+        ) {
+            return m_colors.get();
+        }
+
+        baseColorType const *getColorData
+        (
+        ) const {
+            return m_colors.get();
+        }
+
         std::wstring pixelsToWString
         (
         ) const {
@@ -285,131 +321,125 @@ namespace CGE {
         }
     };
 
-    class BaseGameEngine {
+    // Set of drawing routines that render into a Sprite
+    // BaseGameEngine is a Canvas that draws on screen by default,
+    // but any Sprite can be made a draw target to render image once and reuse it later
+    class Canvas {
     public:
-        BaseGameEngine
+        Canvas
         (
+        ) = default;
+
+        // Canvas that draws into given sprite
+        Canvas
+        ( Sprite &target
         ) {
-            m_screenHandler = GetStdHandle(STD_OUTPUT_HANDLE);
-            m_inputHandler = GetStdHandle(STD_INPUT_HANDLE);
-            m_appName = L"Default";
+            setDefaultDrawTarget(&target);
         }
 
-        virtual ~BaseGameEngine
-        (
+        // Changes Sprite that all drawing routines write to
+        // nullptr restores default target (screen for game engine)
+        // Scissor and viewport stacks are reset to cover whole new target
+        void setDrawTarget
+        ( Sprite *target
         ) {
-            SetConsoleActiveScreenBuffer(m_originalScreenHandler);
+            m_drawTarget = target ? target : m_defaultDrawTarget;
+            resetClipping();
         }
 
-        static BOOL CloseHandler(DWORD evt)
-        {
-            // Note this gets called in a seperate OS thread, so it must
-            // only exit when the game has finished cleaning up, or else
-            // the process will be killed before OnUserDestroy() has finished
-            if (evt == CTRL_CLOSE_EVENT)
-            {
-                m_atomActive = false;
-
-                // Wait for thread to be exited
-                std::unique_lock<std::mutex> ul(m_muxGame);
-                m_gameFinished.wait(ul);
-            }
-            return true;
+        Sprite *getDrawTarget
+        (
+        ) const {
+            return m_drawTarget;
         }
 
-        bool createConsole
-        ( short screenWidth
-        , short screenHeight
-        , short fontWidth
-        , short fontHeight
-        ) {
-            if (m_screenHandler == INVALID_HANDLE_VALUE || m_inputHandler == INVALID_HANDLE_VALUE) {
-                reportError(L"Bad handle recieved!");
-                return false;
-            }
-
-            m_screenWidth = screenWidth;
-            m_screenHeight = screenHeight;
-
-            // Console can behave differently on some systems
-            // and there's no info why in MSDN
-            // Partial solution for this is taken from original code
-            // by Javidx9 - https://github.com/OneLoneCoder/videos/blob/master/olcConsoleGameEngine.h
+        short getDrawTargetWidth
+        (
+        ) const {
+            return m_drawTarget->getWidth();
+        }
 
-            // Change console visual size to a minimum so ScreenBuffer can shrink
-            // below the actual visual size
-            m_rectWindow = { 0, 0, 1, 1 };
-            if (!SetConsoleWindowInfo(m_screenHandler, TRUE, &m_rectWindow)) {
-                reportError(L"SetConsoleWindowInfo failed!");
-                return false;
-            }
+        short getDrawTargetHeight
+        (
+        ) const {
+            return m_drawTarget->getHeight();
+        }
 
-            // Set the size of the screen buffer
-            COORD coord{ m_screenWidth, m_screenHeight };
-            if (!SetConsoleScreenBufferSize(m_screenHandler, coord)) {
-                reportError(L"SetConsoleScreenBufferSize failed!");
-                return false;
-            }
+        // Limits drawing to a rectangle given in current viewport coordinates
+        // New scissor is intersected with previous one so it can only shrink
+        // Every pushScissor must be matched with popScissor
+        void pushScissor
+        ( short x
+        , short y
+        , short width
+        , short height
+        ) {
+            m_scissorStack.push_back(m_scissor);
+            m_scissor = intersectRects(m_scissor, makeRect(m_originX + x, m_originY + y, width, height));
+        }
 
-            // Assign screen buffer to the console
-            if (!SetConsoleActiveScreenBuffer(m_screenHandler)) {
-                reportError(L"SetConsoleActiveScreenBuffer failed!");
-                return false;
+        void popScissor
+        (
+        ) {
+            if (!m_scissorStack.empty()) {
+                m_scissor = m_scissorStack.back();
+                m_scissorStack.pop_back();
             }
+        }
 
-            // Set the font size now that the screen buffer has been assigned to the console
-            CONSOLE_FONT_INFOEX fontInfo{};
-            fontInfo.cbSize = sizeof(fontInfo);
-            fontInfo.nFont = 0;
-            fontInfo.dwFontSize.X = fontWidth;
-            fontInfo.dwFontSize.Y = fontHeight;
-            fontInfo.FontFamily = FF_DONTCARE;
-            fontInfo.FontWeight = FW_NORMAL;
-            wcscpy_s(fontInfo.FaceName, L"Consolas");
-            if (!SetCurrentConsoleFontEx(m_screenHandler, FALSE, &fontInfo)) {
-                reportError(L"SetCurrentConsoleFontEx failed!");
-                return false;
-            }
+        // Moves coordinates origin to (x, y) of current viewport and limits drawing
+        // to rectangle of given size, so code can draw into part of a target
+        // same way it draws into whole target
+        // Every pushViewport must be matched with popViewport
+        void pushViewport
+        ( short x
+        , short y
+        , short width
+        , short height
+        ) {
+            m_viewportStack.push_back({ m_originX, m_originY, m_viewportWidth, m_viewportHeight, m_scissor, m_scissorStack.size() });
+            m_scissor = intersectRects(m_scissor, makeRect(m_originX + x, m_originY + y, width, height));
+            m_originX += x;
+            m_originY += y;
+            m_viewportWidth = width;
+            m_viewportHeight = height;
+        }
 
-            // Get screen buffer info and check the maximum allowed window size. 
-            // Return error if exceeded, so user knows their dimensions/fontsize are too large
-            CONSOLE_SCREEN_BUFFER_INFO scrInfo{};
-            if (!GetConsoleScreenBufferInfo(m_screenHandler, &scrInfo)) {
-                reportError(L"GetConsoleScreenBufferInfo failed!");
-                return false;
-            }
-            if (m_screenWidth > scrInfo.dwMaximumWindowSize.X) {
-                reportError(L"Requested screen width was too big, failed to create such screen!");
-                return false;
-            }
-            if (m_screenHeight > scrInfo.dwMaximumWindowSize.Y) {
-                reportError(L"Requested screen height was too big, failed to create such screen!");
-                return false;
-            }
-         
-            // Set Physical Console Window Size
-            m_rectWindow = { 0, 0, m_screenWidth - 1, m_screenHeight - 1 };
-            if (!SetConsoleWindowInfo(m_screenHandler, TRUE, &m_rectWindow)) {
-                reportError(L"SetConsoleWindowInfo failed!");
-                return false;
+        // Restores viewport and scissor that were active before last pushViewport
+        void popViewport
+        (
+        ) {
+            if (!m_viewportStack.empty()) {
+                ViewportState const &state = m_viewportStack.back();
+                m_originX = state.originX;
+                m_originY = state.originY;
+                m_viewportWidth = state.width;
+                m_viewportHeight = state.height;
+                m_scissor = state.scissor;
+                m_scissorStack.resize(state.scissorStackSize);
+                m_viewportStack.pop_back();
             }
+        }
 
-            m_screenBuf = std::make_unique<CHAR_INFO[]>(m_screenWidth * m_screenHeight);
-            std::memset(m_screenBuf.get(), 0, m_screenWidth * m_screenHeight * sizeof(CHAR_INFO));
-
-            SetConsoleCtrlHandler(reinterpret_cast<PHANDLER_ROUTINE>(CloseHandler), TRUE);
-
-            SetConsoleTitleW(m_appName.c_str());
+        // Size of current viewport - whole draw target if no viewport was pushed
+        short getViewportWidth
+        (
+        ) const {
+            return m_viewportWidth;
+        }
 
-            return true;
+        short getViewportHeight
+        (
+        ) const {
+            return m_viewportHeight;
         }
 
-        void start
+        // Current scissor rectangle in draw target coordinates
+        // Right and Bottom are inclusive, rectangle is empty if Right < Left or Bottom < Top
+        SMALL_RECT getScissor
         (
-        ) {
-            m_atomActive = true;
-            std::thread gameThread(&BaseGameEngine::gameThread, this);
-            gameThread.join();
+        ) const {
+            return m_scissor;
         }
 
         void draw
@@ -418,9 +448,12 @@ namespace CGE {
         , basePixelType pix = Pixel::Solid
         , baseColorType col = Color::FG_White
         ) {
-            if (x >= 0 && x < m_screenWidth && y >= 0 && y < m_screenHeight) {
-                m_screenBuf.get()[y * m_screenWidth + x].Char.UnicodeChar = pix;
-                m_screenBuf.get()[y * m_screenWidth + x].Attributes = col;
+            int tx = x + m_originX;
+            int ty = y + m_originY;
+            if (tx >= m_scissor.Left && tx <= m_scissor.Right && ty >= m_scissor.Top && ty <= m_scissor.Bottom) {
+                int idx = ty * m_drawTarget->getWidth() + tx;
+                m_drawTarget->getPixelData()[idx] = pix;
+                m_drawTarget->getColorData()[idx] = col;
             }
         }
 
@@ -432,25 +465,34 @@ namespace CGE {
         , basePixelType pix = Pixel::Solid
         , baseColorType col = Color::FG_White
         ) {
-            clipCoords(fromX, fromY);
-            clipCoords(toX, toY);
-            for (short x = fromX; x < toX; ++x) {
-                for (short y = fromY; y < toY; ++y) {
-                    draw(x, y, pix, col);
-                }
+            int top = fromY + m_originY;
+            int bottom = toY + m_originY - 1;
+            if (top < m_scissor.Top) {
+                top = m_scissor.Top;
+            }
+            if (bottom > m_scissor.Bottom) {
+                bottom = m_scissor.Bottom;
+            }
+            for (int y = top; y <= bottom; ++y) {
+                fillSpan(fromX + m_originX, toX + m_originX - 1, y, pix, col);
             }
         }
 
+        // Text doesn't wrap to next line - part outside of scissor is cut off
         void drawString
         ( short x
         , short y
         , std::wstring const &str
         , baseColorType col = Color::FG_White
         ) {
-            for (size_t i = 0; i < str.size(); ++i) {
-                // Not calling draw method to allow line breaks
-                m_screenBuf.get()[y * m_screenWidth + x + i].Char.UnicodeChar = str.at(i);
-                m_screenBuf.get()[y * m_screenWidth + x + i].Attributes = col;
+            int first, last;
+            if (!clipString(x, y, str, first, last)) {
+                return;
+            }
+            int idx = (y + m_originY) * m_drawTarget->getWidth() + x + m_originX;
+            for (int i = first; i <= last; ++i) {
+                m_drawTarget->getPixelData()[idx + i] = str[i];
+                m_drawTarget->getColorData()[idx + i] = col;
             }
         }
 
@@ -461,11 +503,15 @@ namespace CGE {
         , std::wstring const &str
         , baseColorType col = Color::FG_White
         ) {
-            for (size_t i = 0; i < str.size(); ++i) {
-                if (str.at(i) != L' ') {
-                    // Not calling draw method to allow line breaks
-                    m_screenBuf.get()[y * m_screenWidth + x + i].Char.UnicodeChar = str.at(i);
-                    m_screenBuf.get()[y * m_screenWidth + x + i].Attributes = col;
+            int first, last;
+            if (!clipString(x, y, str, first, last)) {
+                return;
+            }
+            int idx = (y + m_originY) * m_drawTarget->getWidth() + x + m_originX;
+            for (int i = first; i <= last; ++i) {
+                if (str[i] != L' ') {
+                    m_drawTarget->getPixelData()[idx + i] = str[i];
+                    m_drawTarget->getColorData()[idx + i] = col;
                 }
             }
         }
@@ -480,6 +526,11 @@ namespace CGE {
         , basePixelType pix = Pixel::Solid
         , baseColorType col = Color::FG_White
         ) {
+            // Whole line is outside of scissor
+            if (isBoxClipped(x1 < x2 ? x1 : x2, y1 < y2 ? y1 : y2, x1 < x2 ? x2 : x1, y1 < y2 ? y2 : y1)) {
+                return;
+            }
+
             int dx = x2 - x1;
             int dy = y2 - y1;
             int dxAbs = std::abs(dx);
@@ -573,10 +624,15 @@ namespace CGE {
             if (y1 > y3) { std::swap(y1, y3); std::swap(x1, x3); }
             if (y2 > y3) { std::swap(y2, y3); std::swap(x2, x3); }
 
-            auto fastDrawScanLine = [&](short startX, short endX, short y) {
-                for (short i = startX; i <= endX; ++i) {
-                    this->draw(i, y, pix, col);
-                }
+            // Whole triangle is outside of scissor - nothing to rasterize
+            short minX = x1 < x2 ? (x1 < x3 ? x1 : x3) : (x2 < x3 ? x2 : x3);
+            short maxX = x1 > x2 ? (x1 > x3 ? x1 : x3) : (x2 > x3 ? x2 : x3);
+            if (isBoxClipped(minX, y1, maxX, y3)) {
+                return;
+            }
+
+            auto fastDrawScanLine = [&](int startX, int endX, int y) {
+                fillSpan(startX + m_originX, endX + m_originX, y + m_originY, pix, col);
             };
 
             int t1x, t2x, y, minx, maxx, t1xp, t2xp;
@@ -717,6 +773,10 @@ namespace CGE {
         , basePixelType pix = Pixel::Solid
         , baseColorType col = Color::FG_White
         ) {
+            if (isBoxClipped(xc - radius, yc - radius, xc + radius, yc + radius)) {
+                return;
+            }
+
             int x = 0;
             int y = radius;
             int p = 3 - 2 * radius;
@@ -748,14 +808,16 @@ namespace CGE {
         , basePixelType pix = Pixel::Solid
         , baseColorType col = Color::FG_White
         ) {
+            if (isBoxClipped(xc - radius, yc - radius, xc + radius, yc + radius)) {
+                return;
+            }
+
             int x = 0;
             int y = radius;
             int p = 3 - 2 * radius;
             if (radius > 0) {
-                auto fastDrawScanLine = [&](short startX, short endX, short y) {
-                    for (short i = startX; i <= endX; ++i) {
-                        this->draw(i, y, pix, col);
-                    }
+                auto fastDrawScanLine = [&](int startX, int endX, int y) {
+                    fillSpan(startX + m_originX, endX + m_originX, y + m_originY, pix, col);
                 };
                 while (y >= x) // only formulate 1/8 of circle
                 {
@@ -778,15 +840,11 @@ namespace CGE {
         , short y
         , Sprite const &sprite
         ) {
-            for (short i = 0; i < sprite.getWidth(); ++i) {
-                for (short j = 0; j < sprite.getHeight(); ++j) {
-                    if (sprite.getPixel(i, j) != L' ') {
-                        draw(x + i, y + j, sprite.getPixel(i, j), sprite.getColor(i, j));
-                    }
-                }
-            }
+            drawSpritePartial(x, y, sprite, 0, 0, sprite.getWidth(), sprite.getHeight());
         }
 
+        // Copies part of a sprite row by row, skipping Empty pixels
+        // Only part that lands inside both sprite and draw target is touched
         void drawSpritePartial
         ( short xScreen
         , short yScreen
@@ -796,85 +854,1127 @@ namespace CGE {
         , short width
         , short height
         ) {
-            for (short i = 0; i < width; ++i) {
-                for (short j = 0; j < height; ++j) {
-                    if (sprite.getPixel(i + xBegin, j + yBegin) != L' ') {
-                        draw(xScreen + i, yScreen + j, sprite.getPixel(i + xBegin, j + yBegin), sprite.getColor(i + xBegin, j + yBegin));
+            int dstX = xScreen + m_originX, dstY = yScreen + m_originY;
+            int srcX = xBegin, srcY = yBegin;
+            int w = width, h = height;
+
+            // Clip against sprite bounds
+            if (srcX < 0) { dstX -= srcX; w += srcX; srcX = 0; }
+            if (srcY < 0) { dstY -= srcY; h += srcY; srcY = 0; }
+            if (srcX + w > sprite.getWidth())  { w = sprite.getWidth() - srcX; }
+            if (srcY + h > sprite.getHeight()) { h = sprite.getHeight() - srcY; }
+
+            // Clip against scissor
+            short targetWidth = m_drawTarget->getWidth();
+            if (dstX < m_scissor.Left) { srcX += m_scissor.Left - dstX; w -= m_scissor.Left - dstX; dstX = m_scissor.Left; }
+            if (dstY < m_scissor.Top)  { srcY += m_scissor.Top - dstY;  h -= m_scissor.Top - dstY;  dstY = m_scissor.Top; }
+            if (dstX + w > m_scissor.Right + 1)  { w = m_scissor.Right + 1 - dstX; }
+            if (dstY + h > m_scissor.Bottom + 1) { h = m_scissor.Bottom + 1 - dstY; }
+
+            if (w <= 0 || h <= 0) {
+                return;
+            }
+
+            for (int j = 0; j < h; ++j) {
+                basePixelType const *srcPix = sprite.getPixelData() + (srcY + j) * sprite.getWidth() + srcX;
+                baseColorType const *srcCol = sprite.getColorData() + (srcY + j) * sprite.getWidth() + srcX;
+                basePixelType *dstPix = m_drawTarget->getPixelData() + (dstY + j) * targetWidth + dstX;
+                baseColorType *dstCol = m_drawTarget->getColorData() + (dstY + j) * targetWidth + dstX;
+                for (int i = 0; i < w; ++i) {
+                    if (srcPix[i] != Pixel::Empty) {
+                        dstPix[i] = srcPix[i];
+                        dstCol[i] = srcCol[i];
                     }
                 }
             }
         }
 
-        // Changes x and y coords so they fit to screen
+        // Changes x and y coords so they fit to scissor
+        // Coords are in current viewport, right and bottom bounds are exclusive
         void clipCoords
         ( short &x
         , short &y
         ) {
-            if (x < 0) {
-                x = 0;
+            if (x < m_scissor.Left - m_originX) {
+                x = m_scissor.Left - m_originX;
             }
-            else if (x >= m_screenWidth) {
-                x = m_screenWidth;
+            else if (x > m_scissor.Right - m_originX) {
+                x = m_scissor.Right - m_originX + 1;
             }
-            if (y < 0) {
-                y = 0;
+            if (y < m_scissor.Top - m_originY) {
+                y = m_scissor.Top - m_originY;
             }
-            else if (y >= m_screenHeight) {
-                y = m_screenHeight;
+            else if (y > m_scissor.Bottom - m_originY) {
+                y = m_scissor.Bottom - m_originY + 1;
             }
         }
 
-        short getScreenWidth
-        (
-        ) const {
-            return m_screenWidth;
+    protected:
+
+        // Sets sprite used when draw target is reset with setDrawTarget(nullptr)
+        void setDefaultDrawTarget
+        ( Sprite *target
+        ) {
+            m_defaultDrawTarget = target;
+            m_drawTarget = target;
+            resetClipping();
         }
 
-        short getScreenHeight
+        // Scissor covers whole draw target, no viewports
+        void resetClipping
         (
-        ) const {
-            return m_screenHeight;
+        ) {
+            m_originX = 0;
+            m_originY = 0;
+            m_viewportWidth = m_drawTarget ? m_drawTarget->getWidth() : 0;
+            m_viewportHeight = m_drawTarget ? m_drawTarget->getHeight() : 0;
+            m_scissor = makeRect(0, 0, m_viewportWidth, m_viewportHeight);
+            m_scissorStack.clear();
+            m_viewportStack.clear();
         }
 
-        void setAppName
-        ( std::wstring const &appName
+        // Fills horizontal line from x1 to x2 (both inclusive) given in draw target coordinates
+        // Part of line outside of scissor is cut off before anything is written
+        void fillSpan
+        ( int x1
+        , int x2
+        , int y
+        , basePixelType pix
+        , baseColorType col
         ) {
-            m_appName = appName;
+            if (y < m_scissor.Top || y > m_scissor.Bottom) {
+                return;
+            }
+            if (x1 < m_scissor.Left) {
+                x1 = m_scissor.Left;
+            }
+            if (x2 > m_scissor.Right) {
+                x2 = m_scissor.Right;
+            }
+            if (x1 > x2) {
+                return;
+            }
+            int idx = y * m_drawTarget->getWidth() + x1;
+            std::fill_n(m_drawTarget->getPixelData() + idx, x2 - x1 + 1, pix);
+            std::fill_n(m_drawTarget->getColorData() + idx, x2 - x1 + 1, col);
         }
 
-        std::wstring getAppName
-        (
+        // True if box given in viewport coordinates (bounds inclusive) doesn't touch scissor
+        bool isBoxClipped
+        ( int minX
+        , int minY
+        , int maxX
+        , int maxY
         ) const {
-            return m_appName;
+            return minX + m_originX > m_scissor.Right || maxX + m_originX < m_scissor.Left ||
+                   minY + m_originY > m_scissor.Bottom || maxY + m_originY < m_scissor.Top;
         }
 
-        // Must be overriden by user class
-        // Used to initialize user resources
-        virtual bool userCreate
-        (
-        ) = 0; 
+        // Finds range of string characters [first; last] that are inside scissor
+        // Returns false if nothing of string is visible
+        bool clipString
+        ( short x
+        , short y
+        , std::wstring const &str
+        , int &first
+        , int &last
+        ) const {
+            int tx = x + m_originX;
+            int ty = y + m_originY;
+            if (str.empty() || ty < m_scissor.Top || ty > m_scissor.Bottom) {
+                return false;
+            }
+            first = tx < m_scissor.Left ? m_scissor.Left - tx : 0;
+            last = static_cast<int>(str.size()) - 1;
+            if (tx + last > m_scissor.Right) {
+                last = m_scissor.Right - tx;
+            }
+            return first <= last;
+        }
 
-        // Must be overriden by user class
-        // Used to update game values and render image inside screen buffer
-        // Elapsed time is time between two calls to this function
-        virtual bool userUpdate
-        ( float elapsedTime
-        ) = 0;
+        // Rectangle with inclusive right and bottom bounds
+        static SMALL_RECT makeRect
+        ( int x
+        , int y
+        , int width
+        , int height
+        ) {
+            SMALL_RECT r;
+            r.Left = static_cast<short>(x);
+            r.Top = static_cast<short>(y);
+            r.Right = static_cast<short>(x + width - 1);
+            r.Bottom = static_cast<short>(y + height - 1);
+            return r;
+        }
 
-        // Can be overriden to clean resources initialized by user class
-        virtual bool userDestroy
-        (
-        ) { 
-            return true; 
+        static SMALL_RECT intersectRects
+        ( SMALL_RECT const &a
+        , SMALL_RECT const &b
+        ) {
+            SMALL_RECT r;
+            r.Left = a.Left > b.Left ? a.Left : b.Left;
+            r.Top = a.Top > b.Top ? a.Top : b.Top;
+            r.Right = a.Right < b.Right ? a.Right : b.Right;
+            r.Bottom = a.Bottom < b.Bottom ? a.Bottom : b.Bottom;
+            return r;
         }
 
-    protected:
+        // Sprite that drawing routines write to
+        Sprite *m_drawTarget = nullptr;
 
-        void gameThread
+        // Sprite that is used when no other target is set
+        Sprite *m_defaultDrawTarget = nullptr;
+
+        // Drawing is allowed only inside this rectangle of draw target
+        SMALL_RECT m_scissor{ 0, 0, -1, -1 };
+
+        // Offset added to all coordinates - top left corner of current viewport
+        short m_originX = 0;
+        short m_originY = 0;
+
+        short m_viewportWidth = 0;
+        short m_viewportHeight = 0;
+
+        struct ViewportState {
+            short originX;
+            short originY;
+            short width;
+            short height;
+            SMALL_RECT scissor;
+            size_t scissorStackSize;
+        };
+
+        std::vector<SMALL_RECT> m_scissorStack;
+        std::vector<ViewportState> m_viewportStack;
+    };
+
+    // 4x4 Bayer matrix - thresholds in [0; 1) used for ordered dithering
+    // Value that is between two levels is rounded up if its fraction is bigger than threshold for that pixel
+    inline constexpr float orderedDither4x4[4][4] = {
+        {  0.0f / 16.0f,  8.0f / 16.0f,  2.0f / 16.0f, 10.0f / 16.0f },
+        { 12.0f / 16.0f,  4.0f / 16.0f, 14.0f / 16.0f,  6.0f / 16.0f },
+        {  3.0f / 16.0f, 11.0f / 16.0f,  1.0f / 16.0f,  9.0f / 16.0f },
+        { 15.0f / 16.0f,  7.0f / 16.0f, 13.0f / 16.0f,  5.0f / 16.0f }
+    };
+
+    // Precomputed table that turns value in [0; 1] (light, height, noise...) into glyph and color
+    // Ramp starts with one solid base color, every band after it goes through 4 glyph densities
+    // (Quarter, Half, ThreeQuarters, Solid) of its FG color drawn over its BG color
+    class ShadeRamp {
+    public:
+        static constexpr int tableSize = 256;
+
+        // Colors of one band of ramp
+        struct Band {
+            baseColorType m_background;
+            baseColorType m_foreground;
+        };
+
+        // Grey ramp - black, dark grey, grey and white
+        ShadeRamp
         (
+        ) : ShadeRamp(Color::FG_Black, { { Color::BG_Black, Color::FG_DarkGrey }, { Color::BG_DarkGrey, Color::FG_Grey }, { Color::BG_Grey, Color::FG_White } }) {
+        }
+
+        ShadeRamp
+        ( baseColorType baseColor
+        , std::vector<Band> const &bands
         ) {
-            if (!userCreate()) {
-                m_atomActive = false;
+            static constexpr basePixelType densities[4] = { Pixel::Quarter, Pixel::Half, Pixel::ThreeQuarters, Pixel::Solid };
+            std::vector<CHAR_INFO> levels;
+            levels.push_back(makeCell(Pixel::Solid, (baseColor & 0x0F) | ((baseColor & 0x0F) << 4)));
+            for (Band const &band : bands) {
+                for (basePixelType density : densities) {
+                    levels.push_back(makeCell(density, (band.m_background & 0xF0) | (band.m_foreground & 0x0F)));
+                }
+            }
+            m_levelCount = static_cast<int>(levels.size());
+
+            // Every entry is computed for value in the middle of its part of [0; 1]
+            for (int i = 0; i < tableSize; ++i) {
+                float value = (i + 0.5f) / tableSize;
+                int level = static_cast<int>(value * m_levelCount);
+                m_table[i] = levels[level < m_levelCount ? level : m_levelCount - 1];
+
+                // Dithered value is rounded up to next level when its fraction is bigger than threshold
+                for (int t = 0; t < 16; ++t) {
+                    level = static_cast<int>(value * (m_levelCount - 1) + orderedDither4x4[t >> 2][t & 3]);
+                    m_dithered[t][i] = levels[level < m_levelCount ? level : m_levelCount - 1];
+                }
+            }
+        }
+
+        // Number of different cells in ramp
+        int getLevelCount
+        (
+        ) const {
+            return m_levelCount;
+        }
+
+        // Cell for value, values outside of [0; 1] are clamped
+        CHAR_INFO const &lookup
+        ( float value
+        ) const {
+            return m_table[toIndex(value)];
+        }
+
+        // Cell for value at screen position x, y - neighbour cells mix two closest levels
+        // so smooth gradients don't turn into visible bands
+        CHAR_INFO const &lookup
+        ( float value
+        , int x
+        , int y
+        ) const {
+            return m_dithered[((y & 3) << 2) | (x & 3)][toIndex(value)];
+        }
+
+    private:
+        static CHAR_INFO makeCell
+        ( basePixelType pixel
+        , baseColorType color
+        ) {
+            CHAR_INFO c;
+            c.Char.UnicodeChar = pixel;
+            c.Attributes = color;
+            return c;
+        }
+
+        static int toIndex
+        ( float value
+        ) {
+            int index = static_cast<int>(value * tableSize);
+            return index < 0 ? 0 : (index >= tableSize ? tableSize - 1 : index);
+        }
+
+        int m_levelCount;
+        CHAR_INFO m_table[tableSize];
+        CHAR_INFO m_dithered[16][tableSize];
+    };
+
+    // Precomputed table that turns true color (for example pixel of imported image) into closest console cell
+    // Cell is one of glyph densities of FG color over BG color, so its color is mix of both colors
+    // Every channel is cut to bitsPerChannel bits - table has one entry for every cube of colors
+    class ColorQuantizer {
+    public:
+        static constexpr int bitsPerChannel = 5;
+        static constexpr int channelSize = 1 << bitsPerChannel;
+
+        // Colors of default Windows console palette
+        ColorQuantizer
+        (
+        ) : ColorQuantizer({
+                0x000000, 0x000080, 0x008000, 0x008080, 0x800000, 0x800080, 0x808000, 0xC0C0C0,
+                0x808080, 0x0000FF, 0x00FF00, 0x00FFFF, 0xFF0000, 0xFF00FF, 0xFFFF00, 0xFFFFFF
+            }) {
+        }
+
+        // Palette holds 0xRRGGBB of every console color in order of Color enum
+        ColorQuantizer
+        ( std::vector<uint32_t> const &palette
+        ) : m_table(channelSize * channelSize * channelSize) {
+            struct Candidate {
+                float m_r, m_g, m_b;
+                CHAR_INFO m_cell;
+            };
+            static constexpr basePixelType densities[3] = { Pixel::Quarter, Pixel::Half, Pixel::ThreeQuarters };
+            static constexpr float coverage[3] = { 0.25f, 0.5f, 0.75f };
+
+            // Every solid color and every mix of two different colors
+            std::vector<Candidate> candidates;
+            for (int fg = 0; fg < 16; ++fg) {
+                uint32_t f = palette[fg];
+                for (int bg = 0; bg < 16; ++bg) {
+                    uint32_t b = palette[bg];
+                    for (int d = 0; d < (bg == fg ? 1 : 3); ++d) {
+                        float c = bg == fg ? 1.0f : coverage[d];
+                        Candidate candidate;
+                        candidate.m_r = ((f >> 16) & 0xFF) * c + ((b >> 16) & 0xFF) * (1.0f - c);
+                        candidate.m_g = ((f >> 8) & 0xFF) * c + ((b >> 8) & 0xFF) * (1.0f - c);
+                        candidate.m_b = (f & 0xFF) * c + (b & 0xFF) * (1.0f - c);
+                        candidate.m_cell.Char.UnicodeChar = bg == fg ? static_cast<basePixelType>(Pixel::Solid) : densities[d];
+                        candidate.m_cell.Attributes = static_cast<baseColorType>((bg << 4) | fg);
+                        candidates.push_back(candidate);
+                    }
+                }
+            }
+
+            // Entry gets cell closest to color in the middle of its cube
+            float half = static_cast<float>(1 << (7 - bitsPerChannel));
+            for (int r = 0; r < channelSize; ++r) {
+                for (int g = 0; g < channelSize; ++g) {
+                    for (int b = 0; b < channelSize; ++b) {
+                        float cr = static_cast<float>(r << (8 - bitsPerChannel)) + half;
+                        float cg = static_cast<float>(g << (8 - bitsPerChannel)) + half;
+                        float cb = static_cast<float>(b << (8 - bitsPerChannel)) + half;
+                        float bestDistance = 1e30f;
+                        CHAR_INFO best = candidates.front().m_cell;
+                        for (Candidate const &candidate : candidates) {
+                            float dr = candidate.m_r - cr;
+                            float dg = candidate.m_g - cg;
+                            float db = candidate.m_b - cb;
+                            float distance = dr * dr + dg * dg + db * db;
+                            if (distance < bestDistance) {
+                                bestDistance = distance;
+                                best = candidate.m_cell;
+                            }
+                        }
+                        m_table[(r * channelSize + g) * channelSize + b] = best;
+                    }
+                }
+            }
+        }
+
+        CHAR_INFO const &lookup
+        ( uint8_t r
+        , uint8_t g
+        , uint8_t b
+        ) const {
+            static constexpr int shift = 8 - bitsPerChannel;
+            return m_table[(((r >> shift) * channelSize) + (g >> shift)) * channelSize + (b >> shift)];
+        }
+
+        // Converts image with 3 bytes per pixel (r, g, b), row by row, into sprite
+        Sprite convert
+        ( uint8_t const *rgb
+        , short width
+        , short height
+        ) const {
+            Sprite sprite(width, height);
+            for (int i = 0; i < width * height; ++i) {
+                CHAR_INFO const &cell = lookup(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+                sprite.getPixelData()[i] = cell.Char.UnicodeChar;
+                sprite.getColorData()[i] = cell.Attributes;
+            }
+            return sprite;
+        }
+
+    private:
+        std::vector<CHAR_INFO> m_table;
+    };
+
+    // Full screen effect applied to rendered image after userUpdate and viewports
+    // Rows of image are split between threads, so process must change only rows in [rowBegin; rowEnd)
+    class PostProcessPass {
+    public:
+        virtual ~PostProcessPass
+        (
+        ) = default;
+
+        // Called once per frame on one thread before rows are processed
+        virtual void begin
+        ( Sprite const & /*image*/
+        ) {
+        }
+
+        virtual void process
+        ( Sprite &image
+        , int rowBegin
+        , int rowEnd
+        ) = 0;
+    };
+
+    // Replaces colors using 256 entry table - one entry for each FG/BG combination
+    class ColorRemapPass : public PostProcessPass {
+    public:
+        // Starts with table that doesn't change anything
+        ColorRemapPass
+        (
+        ) {
+            for (int i = 0; i < 256; ++i) {
+                m_table[i] = static_cast<baseColorType>(i);
+            }
+        }
+
+        // Every FG color "from" becomes "to", BG color is kept
+        void remapForeground
+        ( baseColorType from
+        , baseColorType to
+        ) {
+            for (int bg = 0; bg < 16; ++bg) {
+                baseColorType &entry = m_table[(bg << 4) | (from & 0x0F)];
+                entry = (entry & 0xF0) | (to & 0x0F);
+            }
+        }
+
+        // Every BG color "from" becomes "to", FG color is kept
+        void remapBackground
+        ( baseColorType from
+        , baseColorType to
+        ) {
+            for (int fg = 0; fg < 16; ++fg) {
+                baseColorType &entry = m_table[(from & 0xF0) | fg];
+                entry = (entry & 0x0F) | (to & 0xF0);
+            }
+        }
+
+        // Sets result for one exact FG/BG combination
+        void setEntry
+        ( baseColorType from
+        , baseColorType to
+        ) {
+            m_table[from & 0xFF] = to & 0xFF;
+        }
+
+        void process
+        ( Sprite &image
+        , int rowBegin
+        , int rowEnd
+        ) override {
+            baseColorType *colors = image.getColorData() + rowBegin * image.getWidth();
+            int count = (rowEnd - rowBegin) * image.getWidth();
+            for (int i = 0; i < count; ++i) {
+                colors[i] = (colors[i] & 0xFF00) | m_table[colors[i] & 0xFF];
+            }
+        }
+
+    private:
+        baseColorType m_table[256];
+    };
+
+    // Shades image using per pixel light values in [0; 1] given by user
+    // Light is turned into one of 5 glyph densities with ordered dithering
+    // so smooth gradients don't turn into visible bands
+    class DitherShadePass : public PostProcessPass {
+    public:
+        // Light values - one float per pixel, row by row
+        // Pass is skipped in frames where size of light buffer differs from rendered image
+        // (for example when dynamic resolution changed size of image)
+        void setLight
+        ( float const *light
+        , int width
+        , int height
+        ) {
+            m_light = light;
+            m_width = width;
+            m_height = height;
+        }
+
+        void begin
+        ( Sprite const &image
+        ) override {
+            m_active = m_light && m_width == image.getWidth() && m_height == image.getHeight();
+        }
+
+        void process
+        ( Sprite &image
+        , int rowBegin
+        , int rowEnd
+        ) override {
+            if (!m_active) {
+                return;
+            }
+            static constexpr basePixelType levels[5] = { Pixel::Empty, Pixel::Quarter, Pixel::Half, Pixel::ThreeQuarters, Pixel::Solid };
+            int width = image.getWidth();
+            for (int y = rowBegin; y < rowEnd; ++y) {
+                float const *light = m_light + y * width;
+                basePixelType *pixels = image.getPixelData() + y * width;
+                float const *threshold = orderedDither4x4[y & 3];
+                for (int x = 0; x < width; ++x) {
+                    float l = light[x] < 0.0f ? 0.0f : (light[x] > 1.0f ? 1.0f : light[x]);
+                    int level = static_cast<int>(l * 4.0f + threshold[x & 3]);
+                    pixels[x] = levels[level > 4 ? 4 : level];
+                }
+            }
+        }
+
+    private:
+        float const *m_light = nullptr;
+        int m_width = 0;
+        int m_height = 0;
+        bool m_active = false;
+    };
+
+    // Covers distant pixels with fog using per pixel distance given by user
+    // Between fogStart and fogEnd amount of fog grows, ordered dithering mixes
+    // fog with image so transition looks smooth
+    class DepthFogPass : public PostProcessPass {
+    public:
+        DepthFogPass
+        ( float fogStart
+        , float fogEnd
+        , basePixelType fogPixel = Pixel::Solid
+        , baseColorType fogColor = Color::FG_DarkGrey
+        ) : m_fogStart(fogStart)
+          , m_invFogLength(1.0f / (fogEnd - fogStart))
+          , m_fogPixel(fogPixel)
+          , m_fogColor(fogColor) {
+        }
+
+        // Distances - one float per pixel, row by row
+        // Pass is skipped in frames where size of depth buffer differs from rendered image
+        void setDepth
+        ( float const *depth
+        , int width
+        , int height
+        ) {
+            m_depth = depth;
+            m_width = width;
+            m_height = height;
+        }
+
+        void begin
+        ( Sprite const &image
+        ) override {
+            m_active = m_depth && m_width == image.getWidth() && m_height == image.getHeight();
+        }
+
+        void process
+        ( Sprite &image
+        , int rowBegin
+        , int rowEnd
+        ) override {
+            if (!m_active) {
+                return;
+            }
+            int width = image.getWidth();
+            for (int y = rowBegin; y < rowEnd; ++y) {
+                float const *depth = m_depth + y * width;
+                basePixelType *pixels = image.getPixelData() + y * width;
+                baseColorType *colors = image.getColorData() + y * width;
+                float const *threshold = orderedDither4x4[y & 3];
+                for (int x = 0; x < width; ++x) {
+                    bool fogged = (depth[x] - m_fogStart) * m_invFogLength > threshold[x & 3];
+                    pixels[x] = fogged ? m_fogPixel : pixels[x];
+                    colors[x] = fogged ? m_fogColor : colors[x];
+                }
+            }
+        }
+
+    private:
+        float const *m_depth = nullptr;
+        int m_width = 0;
+        int m_height = 0;
+        bool m_active = false;
+        float m_fogStart;
+        float m_invFogLength;
+        basePixelType m_fogPixel;
+        baseColorType m_fogColor;
+    };
+
+    // Draws outline where color of a pixel differs from pixel to the right or below
+    class EdgeOutlinePass : public PostProcessPass {
+    public:
+        EdgeOutlinePass
+        ( basePixelType outlinePixel = Pixel::Solid
+        , baseColorType outlineColor = Color::FG_Black
+        ) : m_outlinePixel(outlinePixel)
+          , m_outlineColor(outlineColor) {
+        }
+
+        // Neighbour rows can be changed by other threads - compare with copy of colors
+        void begin
+        ( Sprite const &image
+        ) override {
+            m_colors.assign(image.getColorData(), image.getColorData() + image.getWidth() * image.getHeight());
+        }
+
+        void process
+        ( Sprite &image
+        , int rowBegin
+        , int rowEnd
+        ) override {
+            int width = image.getWidth();
+            int height = image.getHeight();
+            for (int y = rowBegin; y < rowEnd; ++y) {
+                baseColorType const *row = m_colors.data() + y * width;
+                baseColorType const *below = y + 1 < height ? row + width : row;
+                basePixelType *pixels = image.getPixelData() + y * width;
+                baseColorType *colors = image.getColorData() + y * width;
+                for (int x = 0; x < width; ++x) {
+                    baseColorType right = x + 1 < width ? row[x + 1] : row[x];
+                    bool edge = row[x] != right || row[x] != below[x];
+                    pixels[x] = edge ? m_outlinePixel : pixels[x];
+                    colors[x] = edge ? m_outlineColor : colors[x];
+                }
+            }
+        }
+
+    private:
+        std::vector<baseColorType> m_colors;
+        basePixelType m_outlinePixel;
+        baseColorType m_outlineColor;
+    };
+
+    // Pool of worker threads used to run independent jobs in parallel
+    // Thread that calls parallelFor works on jobs too and returns when all of them are finished
+    class ThreadPool {
+    public:
+        // By default uses one thread per CPU core (including thread that calls parallelFor)
+        ThreadPool
+        ( unsigned numWorkers = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0
+        ) {
+            for (unsigned i = 0; i < numWorkers; ++i) {
+                m_workers.emplace_back(&ThreadPool::workerThread, this);
+            }
+        }
+
+        ThreadPool
+        ( ThreadPool const &p
+        ) = delete;
+
+        ~ThreadPool
+        (
+        ) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (auto &worker : m_workers) {
+                worker.join();
+            }
+        }
+
+        // Number of threads that execute jobs
+        unsigned getNumThreads
+        (
+        ) const {
+            return static_cast<unsigned>(m_workers.size()) + 1;
+        }
+
+        // Calls job(i) for every i in [0; count), calls are spread between threads
+        // If called from inside of a job - runs all calls on current thread
+        void parallelFor
+        ( int count
+        , std::function<void(int)> const &job
+        ) {
+            if (count <= 0) {
+                return;
+            }
+            if (m_workers.empty() || count == 1 || t_insideJob) {
+                for (int i = 0; i < count; ++i) {
+                    job(i);
+                }
+                return;
+            }
+
+            std::lock_guard<std::mutex> callLock(m_callMutex);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_job = &job;
+                m_jobCount = count;
+                m_nextJob = 0;
+                m_activeWorkers = m_workers.size();
+                ++m_generation;
+            }
+            m_wake.notify_all();
+
+            runJobs();
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_finished.wait(lock, [this]() { return m_activeWorkers == 0; });
+            m_job = nullptr;
+        }
+
+    private:
+        void runJobs
+        (
+        ) {
+            t_insideJob = true;
+            int i;
+            while ((i = m_nextJob.fetch_add(1)) < m_jobCount) {
+                (*m_job)(i);
+            }
+            t_insideJob = false;
+        }
+
+        void workerThread
+        (
+        ) {
+            size_t seenGeneration = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wake.wait(lock, [&]() { return m_stop || m_generation != seenGeneration; });
+                    if (m_stop) {
+                        return;
+                    }
+                    seenGeneration = m_generation;
+                }
+
+                runJobs();
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_activeWorkers == 0) {
+                    m_finished.notify_one();
+                }
+            }
+        }
+
+        std::vector<std::thread> m_workers;
+
+        // Only one parallelFor can run at a time
+        std::mutex m_callMutex;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_finished;
+
+        std::function<void(int)> const *m_job = nullptr;
+        int m_jobCount = 0;
+        std::atomic_int m_nextJob{ 0 };
+        size_t m_activeWorkers = 0;
+        size_t m_generation = 0;
+        bool m_stop = false;
+
+        inline static thread_local bool t_insideJob = false;
+    };
+
+    // Rectangular part of the screen that is rendered separately from other parts
+    struct Viewport {
+        short x;
+        short y;
+        short width;
+        short height;
+    };
+
+    class BaseGameEngine : public Canvas {
+    public:
+        BaseGameEngine
+        (
+        ) {
+            m_screenHandler = GetStdHandle(STD_OUTPUT_HANDLE);
+            m_inputHandler = GetStdHandle(STD_INPUT_HANDLE);
+            m_appName = L"Default";
+        }
+
+        virtual ~BaseGameEngine
+        (
+        ) {
+            SetConsoleActiveScreenBuffer(m_originalScreenHandler);
+        }
+
+        static BOOL CloseHandler(DWORD evt)
+        {
+            // Note this gets called in a seperate OS thread, so it must
+            // only exit when the game has finished cleaning up, or else
+            // the process will be killed before OnUserDestroy() has finished
+            if (evt == CTRL_CLOSE_EVENT)
+            {
+                m_atomActive = false;
+
+                // Wait for thread to be exited
+                std::unique_lock<std::mutex> ul(m_muxGame);
+                m_gameFinished.wait(ul);
+            }
+            return true;
+        }
+
+        bool createConsole
+        ( short screenWidth
+        , short screenHeight
+        , short fontWidth
+        , short fontHeight
+        ) {
+            if (m_screenHandler == INVALID_HANDLE_VALUE || m_inputHandler == INVALID_HANDLE_VALUE) {
+                reportError(L"Bad handle recieved!");
+                return false;
+            }
+
+            m_screenWidth = screenWidth;
+            m_screenHeight = screenHeight;
+
+            // Console can behave differently on some systems
+            // and there's no info why in MSDN
+            // Partial solution for this is taken from original code
+            // by Javidx9 - https://github.com/OneLoneCoder/videos/blob/master/olcConsoleGameEngine.h
+
+            // Change console visual size to a minimum so ScreenBuffer can shrink
+            // below the actual visual size
+            m_rectWindow = { 0, 0, 1, 1 };
+            if (!SetConsoleWindowInfo(m_screenHandler, TRUE, &m_rectWindow)) {
+                reportError(L"SetConsoleWindowInfo failed!");
+                return false;
+            }
+
+            // Set the size of the screen buffer
+            COORD coord{ m_screenWidth, m_screenHeight };
+            if (!SetConsoleScreenBufferSize(m_screenHandler, coord)) {
+                reportError(L"SetConsoleScreenBufferSize failed!");
+                return false;
+            }
+
+            // Assign screen buffer to the console
+            if (!SetConsoleActiveScreenBuffer(m_screenHandler)) {
+                reportError(L"SetConsoleActiveScreenBuffer failed!");
+                return false;
+            }
+
+            // Set the font size now that the screen buffer has been assigned to the console
+            CONSOLE_FONT_INFOEX fontInfo{};
+            fontInfo.cbSize = sizeof(fontInfo);
+            fontInfo.nFont = 0;
+            fontInfo.dwFontSize.X = fontWidth;
+            fontInfo.dwFontSize.Y = fontHeight;
+            fontInfo.FontFamily = FF_DONTCARE;
+            fontInfo.FontWeight = FW_NORMAL;
+            wcscpy_s(fontInfo.FaceName, L"Consolas");
+            if (!SetCurrentConsoleFontEx(m_screenHandler, FALSE, &fontInfo)) {
+                reportError(L"SetCurrentConsoleFontEx failed!");
+                return false;
+            }
+
+            // Get screen buffer info and check the maximum allowed window size. 
+            // Return error if exceeded, so user knows their dimensions/fontsize are too large
+            CONSOLE_SCREEN_BUFFER_INFO scrInfo{};
+            if (!GetConsoleScreenBufferInfo(m_screenHandler, &scrInfo)) {
+                reportError(L"GetConsoleScreenBufferInfo failed!");
+                return false;
+            }
+            if (m_screenWidth > scrInfo.dwMaximumWindowSize.X) {
+                reportError(L"Requested screen width was too big, failed to create such screen!");
+                return false;
+            }
+            if (m_screenHeight > scrInfo.dwMaximumWindowSize.Y) {
+                reportError(L"Requested screen height was too big, failed to create such screen!");
+                return false;
+            }
+         
+            // Set Physical Console Window Size
+            m_rectWindow = { 0, 0, m_screenWidth - 1, m_screenHeight - 1 };
+            if (!SetConsoleWindowInfo(m_screenHandler, TRUE, &m_rectWindow)) {
+                reportError(L"SetConsoleWindowInfo failed!");
+                return false;
+            }
+
+            m_screenBuf = std::make_unique<CHAR_INFO[]>(m_screenWidth * m_screenHeight);
+            std::memset(m_screenBuf.get(), 0, m_screenWidth * m_screenHeight * sizeof(CHAR_INFO));
+
+            // Screen image is a sprite so it can be drawn on same way as any other draw target
+            m_screen = Sprite(m_screenWidth, m_screenHeight);
+            setDefaultDrawTarget(&m_screen);
+
+            SetConsoleCtrlHandler(reinterpret_cast<PHANDLER_ROUTINE>(CloseHandler), TRUE);
+
+            SetConsoleTitleW(m_appName.c_str());
+
+            return true;
+        }
+
+        void start
+        (
+        ) {
+            m_atomActive = true;
+            std::thread gameThread(&BaseGameEngine::gameThread, this);
+            gameThread.join();
+        }
+
+        // Adds part of the screen that is rendered by userUpdateViewport
+        // Viewports are rendered in parallel so they should not overlap
+        // Returns index of viewport that is passed to userUpdateViewport
+        int addViewport
+        ( short x
+        , short y
+        , short width
+        , short height
+        ) {
+            m_viewports.push_back({ x, y, width, height });
+            return static_cast<int>(m_viewports.size()) - 1;
+        }
+
+        void clearViewports
+        (
+        ) {
+            m_viewports.clear();
+        }
+
+        int getViewportCount
+        (
+        ) const {
+            return static_cast<int>(m_viewports.size());
+        }
+
+        Viewport const &getViewport
+        ( int viewportIndex
+        ) const {
+            return m_viewports[viewportIndex];
+        }
+
+        // Adds full screen effect that is applied to image after it was rendered
+        // Passes run in order they were added, returns created pass so it can be configured
+        template<typename PassType, typename... Args>
+        PassType &addPostProcess
+        ( Args&&... args
+        ) {
+            m_postProcess.push_back(std::make_unique<PassType>(std::forward<Args>(args)...));
+            return static_cast<PassType &>(*m_postProcess.back());
+        }
+
+        void clearPostProcess
+        (
+        ) {
+            m_postProcess.clear();
+        }
+
+        // Worker threads shared by everything that engine or user runs in parallel
+        ThreadPool &getThreadPool
+        (
+        ) {
+            if (!m_threadPool) {
+                m_threadPool = std::make_unique<ThreadPool>();
+            }
+            return *m_threadPool;
+        }
+
+        // Lets engine render image in lower resolution when frames take longer than targetFrameTime
+        // Resolution can drop to minScale of console size, image is stretched to fill console
+        // Size of image to draw is given by getRenderWidth() and getRenderHeight()
+        void enableDynamicResolution
+        ( float targetFrameTime
+        , float minScale = 0.5f
+        ) {
+            m_targetFrameTime = targetFrameTime;
+            m_minRenderScale = minScale;
+            m_avgFrameTime = targetFrameTime;
+        }
+
+        void disableDynamicResolution
+        (
+        ) {
+            m_targetFrameTime = 0.0f;
+            setRenderScale(1.0f);
+        }
+
+        // Sets render resolution to part of console size, scale is between 0 and 1
+        // Image drawn on screen is stretched to fill whole console when presented
+        void setRenderScale
+        ( float scale
+        ) {
+            if (scale > 1.0f) {
+                scale = 1.0f;
+            }
+            m_renderScale = scale;
+
+            short width = static_cast<short>(m_screenWidth * scale);
+            short height = static_cast<short>(m_screenHeight * scale);
+            if (width < 1) {
+                width = 1;
+            }
+            if (height < 1) {
+                height = 1;
+            }
+            if (width == m_screen.getWidth() && height == m_screen.getHeight()) {
+                return;
+            }
+
+            m_screen = Sprite(width, height);
+            setDefaultDrawTarget(&m_screen);
+
+            // Console cell -> rendered pixel lookup used when presenting
+            m_presentMapX.resize(m_screenWidth);
+            m_presentMapY.resize(m_screenHeight);
+            for (int x = 0; x < m_screenWidth; ++x) {
+                m_presentMapX[x] = x * width / m_screenWidth;
+            }
+            for (int y = 0; y < m_screenHeight; ++y) {
+                m_presentMapY[y] = y * height / m_screenHeight;
+            }
+        }
+
+        float getRenderScale
+        (
+        ) const {
+            return m_renderScale;
+        }
+
+        // Size of image on screen - same as console size unless render scale was changed
+        short getRenderWidth
+        (
+        ) const {
+            return m_screen.getWidth();
+        }
+
+        short getRenderHeight
+        (
+        ) const {
+            return m_screen.getHeight();
+        }
+
+        // Draws cell at console coordinates straight into shown image, can be used only inside userDrawHUD
+        void drawHUD
+        ( int x
+        , int y
+        , basePixelType pix
+        , baseColorType col
+        ) {
+            if (x < 0 || y < 0 || x >= m_screenWidth || y >= m_screenHeight) {
+                return;
+            }
+            CHAR_INFO &cell = m_screenBuf[y * m_screenWidth + x];
+            cell.Char.UnicodeChar = pix;
+            cell.Attributes = col;
+        }
+
+        short getScreenWidth
+        (
+        ) const {
+            return m_screenWidth;
+        }
+
+        short getScreenHeight
+        (
+        ) const {
+            return m_screenHeight;
+        }
+
+        void setAppName
+        ( std::wstring const &appName
+        ) {
+            m_appName = appName;
+        }
+
+        std::wstring getAppName
+        (
+        ) const {
+            return m_appName;
+        }
+
+        // Must be overriden by user class
+        // Used to initialize user resources
+        virtual bool userCreate
+        (
+        ) = 0; 
+
+        // Must be overriden by user class
+        // Used to update game values and render image inside screen buffer
+        // Elapsed time is time between two calls to this function
+        virtual bool userUpdate
+        ( float elapsedTime
+        ) = 0;
+
+        // Can be overriden to render viewports added with addViewport
+        // Called after userUpdate once for every viewport, calls for different viewports
+        // run in parallel, so only data that belongs to that viewport should be changed here
+        // canvas draws on screen, (0, 0) is top left corner of viewport and nothing is drawn outside of it
+        virtual bool userUpdateViewport
+        ( Canvas & /*canvas*/
+        , int /*viewportIndex*/
+        , float /*elapsedTime*/
+        ) {
+            return true;
+        }
+
+        // Can be overriden to draw HUD (maps, text) with drawHUD at console resolution
+        // Called after rendered image was stretched to console size, so HUD stays sharp at any render scale
+        virtual void userDrawHUD
+        (
+        ) {
+        }
+
+        // Can be overriden to clean resources initialized by user class
+        virtual bool userDestroy
+        (
+        ) { 
+            return true; 
+        }
+
+    protected:
+
+        void gameThread
+        (
+        ) {
+            if (!userCreate()) {
+                m_atomActive = false;
             }
             auto tp1 = std::chrono::steady_clock::now();
             auto tp2 = std::chrono::steady_clock::now();
@@ -886,6 +1986,9 @@ namespace CGE {
                     tp1 = tp2;
                     float elapsedTime = cycleDuration.count();
 
+                    // Resolution is changed only between frames
+                    updateRenderScale(elapsedTime);
+
                     // Keyboard input
                     for (int i = 0; i < numKeyboardKeys; ++i) {
                         m_keyNewState[i] = GetAsyncKeyState(i);
@@ -964,12 +2067,18 @@ namespace CGE {
                     if (!userUpdate(elapsedTime)) {
                         m_atomActive = false;
                     }
+                    if (!m_viewports.empty() && !renderViewports(elapsedTime)) {
+                        m_atomActive = false;
+                    }
+                    if (!m_postProcess.empty()) {
+                        runPostProcess();
+                    }
 
                     // Title update
                     wchar_t buf[256];
                     swprintf_s(buf, 256, L"%ls - FPS: %3.2f", m_appName.c_str(), 1.0f / elapsedTime);
                     SetConsoleTitle(buf);
-                    WriteConsoleOutput(m_screenHandler, m_screenBuf.get(), { m_screenWidth, m_screenHeight }, { 0,0 }, &m_rectWindow);
+                    presentScreen();
                 }
                 if (userDestroy()) { // User allowed to finish
                     SetConsoleActiveScreenBuffer(m_originalScreenHandler);
@@ -982,6 +2091,127 @@ namespace CGE {
             }
         }
 
+        // Runs userUpdateViewport for all viewports in parallel
+        // Returns false if any of calls returned false
+        bool renderViewports
+        ( float elapsedTime
+        ) {
+            while (m_viewportCanvases.size() < m_viewports.size()) {
+                m_viewportCanvases.emplace_back(m_screen);
+            }
+
+            std::atomic_bool allOk{ true };
+            getThreadPool().parallelFor(static_cast<int>(m_viewports.size()), [&](int i) {
+                // Viewports are given in console cells - scale them to render resolution
+                // Edges are scaled separately so neighbouring viewports still touch each other
+                Viewport const &v = m_viewports[i];
+                short left = static_cast<short>(v.x * m_screen.getWidth() / m_screenWidth);
+                short top = static_cast<short>(v.y * m_screen.getHeight() / m_screenHeight);
+                short right = static_cast<short>((v.x + v.width) * m_screen.getWidth() / m_screenWidth);
+                short bottom = static_cast<short>((v.y + v.height) * m_screen.getHeight() / m_screenHeight);
+
+                Canvas &canvas = m_viewportCanvases[i];
+                canvas.setDrawTarget(nullptr);
+                canvas.pushViewport(left, top, right - left, bottom - top);
+                if (!userUpdateViewport(canvas, i, elapsedTime)) {
+                    allOk = false;
+                }
+            });
+            return allOk;
+        }
+
+        // Applies all post process passes to screen image
+        // Each pass is split into bands of rows processed in parallel
+        void runPostProcess
+        (
+        ) {
+            ThreadPool &pool = getThreadPool();
+            int height = m_screen.getHeight();
+            int numBands = static_cast<int>(pool.getNumThreads()) * 4;
+            if (numBands > height) {
+                numBands = height;
+            }
+
+            // Job captures only one reference so std::function doesn't allocate for every pass
+            struct Bands {
+                PostProcessPass *m_pass;
+                Sprite *m_image;
+                int m_height;
+                int m_numBands;
+            } bands{ nullptr, &m_screen, height, numBands };
+            for (auto &pass : m_postProcess) {
+                pass->begin(m_screen);
+                bands.m_pass = pass.get();
+                pool.parallelFor(numBands, [&bands](int band) {
+                    bands.m_pass->process(*bands.m_image, band * bands.m_height / bands.m_numBands, (band + 1) * bands.m_height / bands.m_numBands);
+                });
+            }
+        }
+
+        // Frame time controller for dynamic resolution
+        // Rendering cost is roughly proportional to number of pixels - square of render scale
+        // so scale is moved towards sqrt(target / average frame time), only part of the way
+        // and not more often than twice a second to avoid resolution jumping back and forth
+        void updateRenderScale
+        ( float elapsedTime
+        ) {
+            if (m_targetFrameTime <= 0.0f || elapsedTime <= 0.0f) {
+                return;
+            }
+            m_avgFrameTime += (elapsedTime - m_avgFrameTime) * 0.1f;
+            m_renderScaleCooldown -= elapsedTime;
+            if (m_renderScaleCooldown > 0.0f) {
+                return;
+            }
+
+            float wantedScale = m_renderScale * std::sqrt(m_targetFrameTime / m_avgFrameTime);
+            if (wantedScale < m_minRenderScale) {
+                wantedScale = m_minRenderScale;
+            }
+            else if (wantedScale > 1.0f) {
+                wantedScale = 1.0f;
+            }
+            if (std::fabs(wantedScale - m_renderScale) < 0.05f) {
+                return;
+            }
+            float newScale = m_renderScale + (wantedScale - m_renderScale) * 0.5f;
+            if (std::fabs(wantedScale - newScale) < 0.05f) {
+                newScale = wantedScale;
+            }
+            setRenderScale(newScale);
+            m_renderScaleCooldown = 0.5f;
+        }
+
+        // Copies screen sprite into console buffer and shows it
+        // If render resolution is lower than console size - image is stretched
+        void presentScreen
+        (
+        ) {
+            // User could leave some other sprite as a target
+            setDrawTarget(nullptr);
+
+            basePixelType const *pixels = m_screen.getPixelData();
+            baseColorType const *colors = m_screen.getColorData();
+            if (m_screen.getWidth() == m_screenWidth && m_screen.getHeight() == m_screenHeight) {
+                for (int i = 0; i < m_screenWidth * m_screenHeight; ++i) {
+                    m_screenBuf[i].Char.UnicodeChar = pixels[i];
+                    m_screenBuf[i].Attributes = colors[i];
+                }
+            }
+            else {
+                for (int y = 0; y < m_screenHeight; ++y) {
+                    int srcRow = m_presentMapY[y] * m_screen.getWidth();
+                    CHAR_INFO *dst = m_screenBuf.get() + y * m_screenWidth;
+                    for (int x = 0; x < m_screenWidth; ++x) {
+                        dst[x].Char.UnicodeChar = pixels[srcRow + m_presentMapX[x]];
+                        dst[x].Attributes = colors[srcRow + m_presentMapX[x]];
+                    }
+                }
+            }
+            userDrawHUD();
+            WriteConsoleOutput(m_screenHandler, m_screenBuf.get(), { m_screenWidth, m_screenHeight }, { 0,0 }, &m_rectWindow);
+        }
+
         // Prints out error message
         void reportError
         ( std::wstring const &errorMsg
@@ -999,9 +2229,12 @@ namespace CGE {
         HANDLE m_originalScreenHandler;
         CONSOLE_SCREEN_BUFFER_INFO m_OriginalScreenInfo;
 
-        // RAII array that stores characters and their colors
-        // and is used to create image on screen
+        // Image on screen - default draw target
         // All that you draw on screen goes here
+        Sprite m_screen;
+
+        // RAII array that stores characters and their colors
+        // in format used by console - filled from m_screen each frame
         std::unique_ptr<CHAR_INFO[]> m_screenBuf;
 
         SMALL_RECT m_rectWindow;
@@ -1009,6 +2242,28 @@ namespace CGE {
         // Application name shown in title
         std::wstring m_appName;
 
+        // Parts of the screen rendered in parallel by userUpdateViewport
+        // and canvases used to draw each of them
+        std::vector<Viewport> m_viewports;
+        std::vector<Canvas> m_viewportCanvases;
+
+        std::unique_ptr<ThreadPool> m_threadPool;
+
+        // Full screen effects applied after image is rendered
+        std::vector<std::unique_ptr<PostProcessPass>> m_postProcess;
+
+        // Dynamic resolution - render scale is changed to keep frame time
+        // close to target, 0 target means scale is not controlled
+        float m_renderScale = 1.0f;
+        float m_minRenderScale = 0.5f;
+        float m_targetFrameTime = 0.0f;
+        float m_avgFrameTime = 0.0f;
+        float m_renderScaleCooldown = 0.0f;
+
+        // Rendered pixel column/row shown in each console column/row
+        std::vector<int> m_presentMapX;
+        std::vector<int> m_presentMapY;
+
         // Keyboard key state
         struct keyState {
             bool isPressed;
@@ -280,48 +280,12 @@ class PerlinNoiseGenerator1D : public CGE::BaseGameEngine {
     void draw2DNoise() {
         for (int x = 0; x < m_outputWidth2D; ++x) {
             for (int y = 0; y < m_outputHeight2D; ++y) {
-                CHAR_INFO color = getColor(m_perlinNoise2D[y * m_outputWidth2D + x]);
+                CHAR_INFO const &color = m_terrainRamp.lookup(m_perlinNoise2D[y * m_outputWidth2D + x]);
                 draw((short)x, (short)y, color.Char.UnicodeChar, color.Attributes);
             }
         }
     }
 
-    CHAR_INFO getColor(float val) {
-        CGE::baseColorType bgCol, fgCol;
-        CGE::basePixelType pix;
-        int pixelBw = (int)(16.0f * val);
-        switch (pixelBw) {
-        case 0:  bgCol = CGE::Color::BG_DarkBlue; fgCol = CGE::Color::FG_DarkBlue; pix = CGE::Pixel::Solid; break;
-
-        case 1:  bgCol = CGE::Color::BG_DarkBlue; fgCol = CGE::Color::FG_Blue; pix = CGE::Pixel::Quarter; break;
-        case 2:  bgCol = CGE::Color::BG_DarkBlue; fgCol = CGE::Color::FG_Blue; pix = CGE::Pixel::Half; break;
-        case 3:  bgCol = CGE::Color::BG_DarkBlue; fgCol = CGE::Color::FG_Blue; pix = CGE::Pixel::ThreeQuarters; break;
-        case 4:  bgCol = CGE::Color::BG_DarkBlue; fgCol = CGE::Color::FG_Blue; pix = CGE::Pixel::Solid; break;
-
-        case 5:  bgCol = CGE::Color::BG_Blue; fgCol = CGE::Color::FG_Green; pix = CGE::Pixel::Quarter; break;
-        case 6:  bgCol = CGE::Color::BG_Blue; fgCol = CGE::Color::FG_Green; pix = CGE::Pixel::Half; break;
-        case 7:  bgCol = CGE::Color::BG_Blue; fgCol = CGE::Color::FG_Green; pix = CGE::Pixel::ThreeQuarters; break;
-        case 8:  bgCol = CGE::Color::BG_Blue; fgCol = CGE::Color::FG_Green; pix = CGE::Pixel::Solid; break;
-
-        case 9:  bgCol = CGE::Color::BG_Green; fgCol = CGE::Color::FG_DarkGrey; pix = CGE::Pixel::Quarter; break;
-        case 10: bgCol = CGE::Color::BG_Green; fgCol = CGE::Color::FG_DarkGrey; pix = CGE::Pixel::Half; break;
-        case 11: bgCol = CGE::Color::BG_Green; fgCol = CGE::Color::FG_DarkGrey; pix = CGE::Pixel::ThreeQuarters; break;
-        case 12: bgCol = CGE::Color::BG_Green; fgCol = CGE::Color::FG_DarkGrey; pix = CGE::Pixel::Solid; break;
-
-        case 13: bgCol = CGE::Color::BG_DarkGrey; fgCol = CGE::Color::FG_White; pix = CGE::Pixel::Quarter; break;
-        case 14: bgCol = CGE::Color::BG_DarkGrey; fgCol = CGE::Color::FG_White; pix = CGE::Pixel::Half; break;
-        case 15: bgCol = CGE::Color::BG_DarkGrey; fgCol = CGE::Color::FG_White; pix = CGE::Pixel::ThreeQuarters; break;
-        case 16: bgCol = CGE::Color::BG_DarkGrey; fgCol = CGE::Color::FG_White; pix = CGE::Pixel::Solid; break;
-
-        default: bgCol = CGE::Color::BG_Black; fgCol = CGE::Color::FG_Black; pix = CGE::Pixel::Solid; break;
-        }
-
-        CHAR_INFO c;
-        c.Attributes = bgCol | fgCol;
-        c.Char.UnicodeChar = pix;
-        return c;
-    }
-
     // 1D Noise parameters
     int m_outputLength1D;
     std::unique_ptr<float[]> m_noiseSeed1D;
@@ -335,6 +299,14 @@ class PerlinNoiseGenerator1D : public CGE::BaseGameEngine {
 
     int m_numOctaves;
 
+    // Noise value to cell - deep water, shallow water, grass, rock and snow
+    CGE::ShadeRamp m_terrainRamp{ CGE::Color::FG_DarkBlue, {
+        { CGE::Color::BG_DarkBlue, CGE::Color::FG_Blue },
+        { CGE::Color::BG_Blue, CGE::Color::FG_Green },
+        { CGE::Color::BG_Green, CGE::Color::FG_DarkGrey },
+        { CGE::Color::BG_DarkGrey, CGE::Color::FG_White }
+    } };
+
     enum InterpolationMethod {
         Linear,
         Cosine,